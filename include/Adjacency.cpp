@@ -0,0 +1,48 @@
+#include "Adjacency.h"
+#include "RadixSort.h"
+
+namespace GraphLib {
+    void AdjacencyIndex::build(const size_t points_size, const std::span<const size_t> u,
+                               const std::span<const size_t> v, const std::span<const double> w) {
+        offsets.assign(points_size + 1, 0);
+        size_t entries = 0;
+        for (size_t i = 0; i < w.size(); i++) {
+            if (u[i] != v[i]) {
+                offsets[u[i] + 1]++;
+                offsets[v[i] + 1]++;
+                entries += 2;
+            }
+        }
+        for (size_t p = 0; p < points_size; p++) {
+            offsets[p + 1] += offsets[p];
+        }
+
+        targets.resize(entries);
+        edges.resize(entries);
+        keys.resize(entries);
+        // offsets[p] serves as p's write cursor and ends up at the start of p + 1, so shifting it back by one slot
+        // restores the row starts without a second array.
+        const auto place = [this](const size_t from, const size_t to, const size_t edge, const uint64_t key) {
+            const size_t slot = offsets[from]++;
+            targets[slot] = to;
+            edges[slot] = edge;
+            keys[slot] = key;
+        };
+        for (size_t i = 0; i < w.size(); i++) {
+            if (u[i] != v[i]) {
+                const uint64_t key = weight_key(w[i]);
+                place(u[i], v[i], i, key);
+                place(v[i], u[i], i, key);
+            }
+        }
+        for (size_t p = points_size; p > 0; p--) {
+            offsets[p] = offsets[p - 1];
+        }
+        offsets[0] = 0;
+    }
+
+    size_t AdjacencyIndex::capacity_bytes() const {
+        return (offsets.capacity() + targets.capacity() + edges.capacity()) * sizeof(size_t) +
+               keys.capacity() * sizeof(uint64_t);
+    }
+}
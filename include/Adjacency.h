@@ -0,0 +1,23 @@
+#ifndef ADJACENCY_H
+#define ADJACENCY_H
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace GraphLib {
+    // Compressed sparse row index over an undirected edge list. The neighbours of point p are
+    // targets[offsets[p]..offsets[p + 1]), each stored with the edge it comes from and that edge's weight_key.
+    // Self-loops are left out since they can never be part of a spanning tree.
+    struct AdjacencyIndex {
+        std::vector<size_t> offsets;
+        std::vector<size_t> targets, edges;
+        std::vector<uint64_t> keys;
+
+        void build(size_t points_size, std::span<const size_t> u, std::span<const size_t> v,
+                   std::span<const double> w);
+
+        size_t capacity_bytes() const;
+    };
+}
+
+#endif
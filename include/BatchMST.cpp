@@ -0,0 +1,95 @@
+#include "BatchMST.h"
+#include <mutex>
+
+namespace GraphLib {
+    namespace {
+        void compute(const Graph &graph, const MSTOptions &options, MSTScratch &scratch, BatchResult &result) {
+            const std::span<const size_t> mst = graph.solve_MST(options, result.metrics, scratch);
+            result.points_size = graph.points_size();
+            result.mst.reserve(mst.size());
+            for (const size_t edge: mst) {
+                const Pair pair = graph.get_edge(edge);
+                result.mst.emplace_back(pair.first.index, pair.second.index, pair.weight);
+                result.weight += pair.weight;
+            }
+        }
+    }
+
+    BatchMST::BatchMST(const unsigned threads, const MSTOptions &options) : pool(threads), options(options),
+                                                                           scratch(pool.size()) {
+        // Graphs are spread over the pool, so each one is loaded and solved on a single thread.
+        this->options.threads = 1;
+        this->options.sort_mode = SortMode::Radix;
+        this->options.use_cache = false;
+    }
+
+    unsigned BatchMST::get_threads() const {
+        return pool.size();
+    }
+
+    void BatchMST::run(const size_t size, const BatchOrder order, const Sink &sink,
+                       const std::function<void(size_t index, MSTScratch &scratch, BatchResult &result)> &body) {
+        std::mutex mutex;
+        std::vector<BatchResult> ready(order == BatchOrder::Input ? size : 0);
+        std::vector<bool> done(order == BatchOrder::Input ? size : 0, false);
+        size_t next = 0;
+
+        for (size_t i = 0; i < size; i++) {
+            pool.submit([&, i](const unsigned worker) {
+                BatchResult result;
+                result.index = i;
+                try {
+                    body(i, scratch[worker], result);
+                } catch (const std::exception &e) {
+                    result.mst.clear();
+                    result.weight = 0.0;
+                    result.error = e.what();
+                }
+
+                const std::lock_guard lock(mutex);
+                if (order == BatchOrder::Completion) {
+                    sink(std::move(result));
+                    return;
+                }
+                ready[i] = std::move(result);
+                done[i] = true;
+                while (next < size && done[next]) {
+                    sink(std::move(ready[next]));
+                    next++;
+                }
+            });
+        }
+        pool.wait();
+    }
+
+    void BatchMST::run_files(const std::vector<std::string> &file_paths, const BatchOrder order, const Sink &sink) {
+        run(file_paths.size(), order, sink, [&](const size_t index, MSTScratch &worker_scratch, BatchResult &result) {
+            const Graph graph(file_paths[index], 1);
+            compute(graph, options, worker_scratch, result);
+        });
+    }
+
+    void BatchMST::run_graphs(const std::vector<const Graph *> &graphs, const BatchOrder order, const Sink &sink) {
+        run(graphs.size(), order, sink, [&](const size_t index, MSTScratch &worker_scratch, BatchResult &result) {
+            compute(*graphs[index], options, worker_scratch, result);
+        });
+    }
+
+    std::vector<BatchResult> BatchMST::run_files(const std::vector<std::string> &file_paths) {
+        std::vector<BatchResult> results;
+        results.reserve(file_paths.size());
+        run_files(file_paths, BatchOrder::Input, [&results](BatchResult &&result) {
+            results.push_back(std::move(result));
+        });
+        return results;
+    }
+
+    std::vector<BatchResult> BatchMST::run_graphs(const std::vector<const Graph *> &graphs) {
+        std::vector<BatchResult> results;
+        results.reserve(graphs.size());
+        run_graphs(graphs, BatchOrder::Input, [&results](BatchResult &&result) {
+            results.push_back(std::move(result));
+        });
+        return results;
+    }
+}
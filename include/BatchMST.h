@@ -0,0 +1,51 @@
+#ifndef BATCHMST_H
+#define BATCHMST_H
+#include "Graph.h"
+#include "ThreadPool.h"
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace GraphLib {
+    enum class BatchOrder {
+        Input,
+        Completion
+    };
+
+    struct BatchResult {
+        size_t index = 0;
+        size_t points_size = 0;
+        std::vector<Edge> mst;
+        double weight = 0.0;
+        MSTMetrics metrics;
+        std::string error;
+    };
+
+    class BatchMST {
+    public:
+        using Sink = std::function<void(BatchResult &&result)>;
+
+    private:
+        ThreadPool pool;
+        MSTOptions options;
+        std::vector<MSTScratch> scratch;
+
+        void run(size_t size, BatchOrder order, const Sink &sink,
+                 const std::function<void(size_t index, MSTScratch &scratch, BatchResult &result)> &body);
+
+    public:
+        explicit BatchMST(unsigned threads = 0, const MSTOptions &options = {});
+
+        unsigned get_threads() const;
+
+        void run_files(const std::vector<std::string> &file_paths, BatchOrder order, const Sink &sink);
+
+        void run_graphs(const std::vector<const Graph *> &graphs, BatchOrder order, const Sink &sink);
+
+        std::vector<BatchResult> run_files(const std::vector<std::string> &file_paths);
+
+        std::vector<BatchResult> run_graphs(const std::vector<const Graph *> &graphs);
+    };
+}
+
+#endif
@@ -0,0 +1,69 @@
+#include "ConcurrentUnionFind.h"
+#include <atomic>
+#include <utility>
+
+namespace GraphLib {
+    namespace {
+        static_assert(alignof(size_t) >= std::atomic_ref<size_t>::required_alignment);
+
+        std::atomic_ref<size_t> at(std::vector<size_t> &parent, const size_t node) {
+            return std::atomic_ref(parent[node]);
+        }
+    }
+
+    ConcurrentUnionFind::ConcurrentUnionFind(const size_t n, std::vector<size_t> storage) : parent(std::move(storage)) {
+        parent.resize(n);
+        for (size_t i = 0; i < n; i++) {
+            parent[i] = i;
+        }
+    }
+
+    std::vector<size_t> ConcurrentUnionFind::release() {
+        return std::move(parent);
+    }
+
+    size_t ConcurrentUnionFind::find(size_t node) {
+        while (true) {
+            size_t next = at(parent, node).load(std::memory_order_acquire);
+            if (next == node) {
+                return node;
+            }
+            const size_t grand = at(parent, next).load(std::memory_order_acquire);
+            if (grand != next) {
+                at(parent, node).compare_exchange_weak(next, grand, std::memory_order_acq_rel, std::memory_order_relaxed);
+            }
+            node = grand;
+        }
+    }
+
+    bool ConcurrentUnionFind::same(size_t node_x, size_t node_y) {
+        while (true) {
+            node_x = find(node_x);
+            node_y = find(node_y);
+            if (node_x == node_y) {
+                return true;
+            }
+            if (at(parent, node_x).load(std::memory_order_acquire) == node_x) {
+                return false;
+            }
+        }
+    }
+
+    bool ConcurrentUnionFind::unite(size_t node_x, size_t node_y) {
+        while (true) {
+            node_x = find(node_x);
+            node_y = find(node_y);
+            if (node_x == node_y) {
+                return false;
+            }
+            if (node_x > node_y) {
+                std::swap(node_x, node_y);
+            }
+            size_t expected = node_x;
+            if (at(parent, node_x).compare_exchange_strong(expected, node_y, std::memory_order_acq_rel,
+                                                       std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+    }
+}
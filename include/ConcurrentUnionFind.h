@@ -0,0 +1,29 @@
+#ifndef CONCURRENTUNIONFIND_H
+#define CONCURRENTUNIONFIND_H
+#include <cstddef>
+#include <vector>
+
+namespace GraphLib {
+    // Parents live in a plain vector accessed through std::atomic_ref, so the array can be handed back with release()
+    // and reused by the next run like UnionFindStorage.
+    class ConcurrentUnionFind {
+        std::vector<size_t> parent;
+
+    public:
+        explicit ConcurrentUnionFind(size_t n, std::vector<size_t> storage = {});
+
+        ConcurrentUnionFind(const ConcurrentUnionFind &) = delete;
+
+        ConcurrentUnionFind &operator=(const ConcurrentUnionFind &) = delete;
+
+        std::vector<size_t> release();
+
+        size_t find(size_t node);
+
+        bool same(size_t node_x, size_t node_y);
+
+        bool unite(size_t node_x, size_t node_y);
+    };
+}
+
+#endif
@@ -0,0 +1,153 @@
+#include "Dendrogram.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace GraphLib {
+    Dendrogram::Dendrogram(const Graph &graph, const MSTOptions &options) : points_size(graph.points_size()) {
+        const std::vector<size_t> mst_edges = graph.get_MST(options);
+        std::vector<Edge> mst;
+        mst.reserve(mst_edges.size());
+        for (const size_t edge: mst_edges) {
+            const Pair pair = graph.get_edge(edge);
+            mst.emplace_back(pair.first.index, pair.second.index, pair.weight);
+        }
+        build(mst);
+    }
+
+    Dendrogram::Dendrogram(const size_t points_size, const std::vector<Edge> &mst) : points_size(points_size) {
+        const auto lighter = [](const Edge &a, const Edge &b) {
+            return a.weight < b.weight;
+        };
+        if (std::is_sorted(mst.begin(), mst.end(), lighter)) {
+            build(mst);
+        } else {
+            std::vector<Edge> sorted_mst = mst;
+            std::stable_sort(sorted_mst.begin(), sorted_mst.end(), lighter);
+            build(sorted_mst);
+        }
+    }
+
+    void Dendrogram::build(const std::vector<Edge> &mst) {
+        UnionFind<> uf(points_size);
+        std::vector<size_t> node(points_size);
+        std::vector<size_t> size(points_size, 1);
+        for (size_t i = 0; i < points_size; i++) {
+            node[i] = i;
+        }
+
+        merges.reserve(mst.size());
+        parent.assign(points_size + mst.size(), no_node);
+        for (const Edge &edge: mst) {
+            if (edge.first >= points_size || edge.second >= points_size) {
+                throw std::out_of_range("Edge index out of range: (" + std::to_string(edge.first) + ", " +
+                                        std::to_string(edge.second) + ") with " + std::to_string(points_size) +
+                                        " points");
+            }
+            const size_t root1 = uf.find(edge.first), root2 = uf.find(edge.second);
+            if (root1 == root2) {
+                throw std::runtime_error("Edges do not form a spanning forest: (" + std::to_string(edge.first) +
+                                         ", " + std::to_string(edge.second) + ") closes a cycle");
+            }
+
+            const size_t created = points_size + merges.size();
+            merges.push_back({
+                std::min(node[root1], node[root2]), std::max(node[root1], node[root2]), edge.weight,
+                size[root1] + size[root2]
+            });
+            parent[node[root1]] = created;
+            parent[node[root2]] = created;
+
+            uf.unite(root1, root2);
+            const size_t root = uf.find(root1);
+            node[root] = created;
+            size[root] = merges.back().size;
+        }
+        parent.resize(points_size + merges.size());
+    }
+
+    size_t Dendrogram::get_points_size() const {
+        return points_size;
+    }
+
+    const std::vector<Dendrogram::Merge> &Dendrogram::get_merges() const {
+        return merges;
+    }
+
+    size_t Dendrogram::get_min_clusters() const {
+        return points_size - merges.size();
+    }
+
+    size_t Dendrogram::clusters_for_threshold(const double threshold) const {
+        const auto joined = std::upper_bound(merges.begin(), merges.end(), threshold,
+                                             [](const double value, const Merge &merge) {
+                                                 return value < merge.distance;
+                                             });
+        return points_size - static_cast<size_t>(joined - merges.begin());
+    }
+
+    // One top-down sweep over the tree labels every requested cut. With k clusters the first V - k merges are
+    // applied, so a node heads a cluster when it exists by then and its parent does not.
+    std::vector<std::vector<size_t> > Dendrogram::label_points(const std::vector<size_t> &clusters) const {
+        const size_t nodes_size = parent.size();
+        std::vector<size_t> cuts(clusters.size());
+        std::vector<std::vector<size_t> > node_labels(clusters.size(), std::vector<size_t>(nodes_size, no_node));
+        std::vector<size_t> labels_size(clusters.size(), 0);
+        for (size_t i = 0; i < clusters.size(); i++) {
+            cuts[i] = points_size - std::clamp(clusters[i], get_min_clusters(), points_size);
+        }
+
+        for (size_t node = nodes_size; node-- > 0;) {
+            const size_t up = parent[node];
+            for (size_t i = 0; i < clusters.size(); i++) {
+                if (node >= points_size && node - points_size >= cuts[i]) {
+                    continue;
+                }
+                node_labels[i][node] = up == no_node || up - points_size >= cuts[i]
+                                           ? labels_size[i]++
+                                           : node_labels[i][up];
+            }
+        }
+
+        std::vector<std::vector<size_t> > labels(clusters.size(), std::vector<size_t>(points_size));
+        for (size_t i = 0; i < clusters.size(); i++) {
+            std::vector<size_t> order(labels_size[i], no_node);
+            size_t next = 0;
+            for (size_t point = 0; point < points_size; point++) {
+                size_t &label = order[node_labels[i][point]];
+                if (label == no_node) {
+                    label = next++;
+                }
+                labels[i][point] = label;
+            }
+        }
+        return labels;
+    }
+
+    std::vector<size_t> Dendrogram::labels_for_clusters(const size_t clusters) const {
+        return std::move(label_points({clusters}).front());
+    }
+
+    std::vector<std::vector<size_t> > Dendrogram::labels_for_clusters(const std::vector<size_t> &clusters) const {
+        return label_points(clusters);
+    }
+
+    std::vector<size_t> Dendrogram::labels_for_threshold(const double threshold) const {
+        return labels_for_clusters(clusters_for_threshold(threshold));
+    }
+
+    std::vector<size_t> Dendrogram::cluster_sizes(const size_t clusters) const {
+        return cluster_sizes(labels_for_clusters(clusters));
+    }
+
+    std::vector<size_t> Dendrogram::cluster_sizes(const std::vector<size_t> &labels) {
+        std::vector<size_t> sizes;
+        for (const size_t label: labels) {
+            if (label >= sizes.size()) {
+                sizes.resize(label + 1, 0);
+            }
+            sizes[label]++;
+        }
+        return sizes;
+    }
+}
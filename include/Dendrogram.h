@@ -0,0 +1,52 @@
+#ifndef DENDROGRAM_H
+#define DENDROGRAM_H
+#include "Graph.h"
+#include <vector>
+
+namespace GraphLib {
+    class Dendrogram {
+    public:
+        // Nodes 0..V-1 are the points and node V + i is the cluster created by merge i, as in SciPy's linkage matrix.
+        struct Merge {
+            size_t first, second;
+            double distance;
+            size_t size;
+        };
+
+    private:
+        size_t points_size;
+        std::vector<Merge> merges;
+        std::vector<size_t> parent;
+
+        void build(const std::vector<Edge> &mst);
+
+        std::vector<std::vector<size_t> > label_points(const std::vector<size_t> &clusters) const;
+
+    public:
+        static constexpr size_t no_node = static_cast<size_t>(-1);
+
+        explicit Dendrogram(const Graph &graph, const MSTOptions &options = {});
+
+        Dendrogram(size_t points_size, const std::vector<Edge> &mst);
+
+        size_t get_points_size() const;
+
+        const std::vector<Merge> &get_merges() const;
+
+        size_t get_min_clusters() const;
+
+        size_t clusters_for_threshold(double threshold) const;
+
+        std::vector<size_t> labels_for_clusters(size_t clusters) const;
+
+        std::vector<std::vector<size_t> > labels_for_clusters(const std::vector<size_t> &clusters) const;
+
+        std::vector<size_t> labels_for_threshold(double threshold) const;
+
+        std::vector<size_t> cluster_sizes(size_t clusters) const;
+
+        static std::vector<size_t> cluster_sizes(const std::vector<size_t> &labels);
+    };
+}
+
+#endif
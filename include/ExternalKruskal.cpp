@@ -0,0 +1,389 @@
+#include "ExternalKruskal.h"
+#include "Graph.h"
+#include "RadixSort.h"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <queue>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace GraphLib {
+    namespace {
+        constexpr size_t read_buffer_bytes = 1 << 20;
+        constexpr size_t min_run_buffer_bytes = 1 << 12;
+        constexpr size_t max_token_bytes = 64;
+        constexpr int digit_bits = 8;
+        constexpr size_t radix = 1 << digit_bits;
+        constexpr size_t small_sort_size = 256;
+
+        class EdgeReader {
+            int fd;
+            bool binary;
+
+            std::vector<char> buffer;
+            size_t begin, end;
+            bool eof;
+
+            BinaryHeader header;
+            std::vector<uint64_t> first_buffer, second_buffer;
+            std::vector<double> weight_buffer;
+            size_t buffered, position, next_edge;
+
+            void refill() {
+                std::memmove(buffer.data(), buffer.data() + begin, end - begin);
+                end -= begin;
+                begin = 0;
+                while (!eof && end < buffer.size()) {
+                    const ssize_t bytes = ::read(fd, buffer.data() + end, buffer.size() - end);
+                    if (bytes < 0) {
+                        throw std::runtime_error("Unable to read graph file");
+                    }
+                    eof = bytes == 0;
+                    end += static_cast<size_t>(bytes);
+                }
+            }
+
+            void skip_spaces() {
+                while (true) {
+                    while (begin < end && (buffer[begin] == ' ' || buffer[begin] == '\t' ||
+                                           buffer[begin] == '\n' || buffer[begin] == '\r')) {
+                        begin++;
+                    }
+                    if (end - begin >= max_token_bytes || eof) {
+                        break;
+                    }
+                    refill();
+                }
+            }
+
+            template<typename T>
+            void read_value(T &value) {
+                skip_spaces();
+                const auto [ptr, ec] = std::from_chars(buffer.data() + begin, buffer.data() + end, value);
+                if (ec != std::errc()) {
+                    throw std::runtime_error("Malformed graph file");
+                }
+                begin = static_cast<size_t>(ptr - buffer.data());
+            }
+
+            void read_array(const uint64_t offset, const size_t element_size, void *data, const size_t count) const {
+                const size_t bytes = element_size * count;
+                size_t done = 0;
+                while (done < bytes) {
+                    const ssize_t result = ::pread(fd, static_cast<char *>(data) + done, bytes - done,
+                                                   static_cast<off_t>(offset + next_edge * element_size + done));
+                    if (result <= 0) {
+                        throw std::runtime_error("Truncated binary graph file");
+                    }
+                    done += static_cast<size_t>(result);
+                }
+            }
+
+        public:
+            size_t points_size, edges_size;
+
+            explicit EdgeReader(const std::string &file_path) : binary(false), begin(0), end(0), eof(false),
+                                                                header(), buffered(0), position(0), next_edge(0),
+                                                                points_size(0), edges_size(0) {
+                fd = ::open(file_path.c_str(), O_RDONLY);
+                if (fd < 0) {
+                    throw std::runtime_error("Unable to open file from: " + file_path);
+                }
+
+                if (::pread(fd, &header, sizeof(BinaryHeader), 0) == static_cast<ssize_t>(sizeof(BinaryHeader)) &&
+                    std::memcmp(header.magic, BinaryHeader::magic_value, sizeof(header.magic)) == 0) {
+                    if (header.byte_order != BinaryHeader::byte_order_value) {
+                        ::close(fd);
+                        throw std::runtime_error("Binary graph has foreign byte order: " + file_path);
+                    }
+                    binary = true;
+                    points_size = header.points_size;
+                    edges_size = header.edges_size;
+                    const size_t chunk = read_buffer_bytes / (2 * sizeof(uint64_t) + sizeof(double));
+                    first_buffer.resize(chunk);
+                    second_buffer.resize(chunk);
+                    weight_buffer.resize(chunk);
+                    return;
+                }
+
+                buffer.resize(read_buffer_bytes);
+                refill();
+                read_value(points_size);
+                for (size_t i = 0; i < 2 * points_size; i++) {
+                    double coordinate;
+                    read_value(coordinate);
+                }
+                // A file may end after its points, which Graph loads as a graph without edges.
+                skip_spaces();
+                if (begin < end) {
+                    read_value(edges_size);
+                }
+            }
+
+            EdgeReader(const EdgeReader &) = delete;
+
+            EdgeReader &operator=(const EdgeReader &) = delete;
+
+            ~EdgeReader() {
+                ::close(fd);
+            }
+
+            void next(uint64_t &first, uint64_t &second, double &weight) {
+                if (!binary) {
+                    read_value(first);
+                    read_value(second);
+                    read_value(weight);
+                    return;
+                }
+
+                if (position == buffered) {
+                    buffered = std::min(first_buffer.size(), edges_size - next_edge);
+                    read_array(header.u_offset, sizeof(uint64_t), first_buffer.data(), buffered);
+                    read_array(header.v_offset, sizeof(uint64_t), second_buffer.data(), buffered);
+                    read_array(header.w_offset, sizeof(double), weight_buffer.data(), buffered);
+                    next_edge += buffered;
+                    position = 0;
+                }
+                first = first_buffer[position];
+                second = second_buffer[position];
+                weight = weight_buffer[position];
+                position++;
+            }
+        };
+
+        template<typename T>
+        class RunReader {
+            std::ifstream file;
+            std::vector<T> buffer;
+            size_t position, buffered;
+
+        public:
+            RunReader(const std::string &file_path, const size_t buffer_size) : file(file_path, std::ios::binary),
+                                                                               buffer(buffer_size), position(0),
+                                                                               buffered(0) {
+                if (!file.is_open()) {
+                    throw std::runtime_error("Unable to open run file: " + file_path);
+                }
+            }
+
+            bool next(T &value) {
+                if (position == buffered) {
+                    file.read(reinterpret_cast<char *>(buffer.data()),
+                              static_cast<std::streamsize>(buffer.size() * sizeof(T)));
+                    buffered = static_cast<size_t>(file.gcount()) / sizeof(T);
+                    position = 0;
+                    if (buffered == 0) {
+                        return false;
+                    }
+                }
+                value = buffer[position++];
+                return true;
+            }
+        };
+    }
+
+    ExternalKruskal::ExternalKruskal(const std::string &file_path, const size_t memory_budget,
+                                     const std::string &temp_directory) : file_path(file_path),
+                                                                          temp_directory(temp_directory),
+                                                                          memory_budget(memory_budget),
+                                                                          points_size(0), edges_size(0),
+                                                                          peak_run_memory(0) {
+        if (this->temp_directory.empty()) {
+            this->temp_directory = std::filesystem::temp_directory_path().string();
+        }
+    }
+
+    ExternalKruskal::~ExternalKruskal() {
+        remove_runs();
+    }
+
+    size_t ExternalKruskal::get_runs_size() const {
+        return runs.size();
+    }
+
+    size_t ExternalKruskal::get_peak_run_memory() const {
+        return peak_run_memory;
+    }
+
+    void ExternalKruskal::remove_runs() {
+        for (const std::string &run: runs) {
+            std::filesystem::remove(run);
+        }
+        runs.clear();
+    }
+
+    void ExternalKruskal::spill_run(std::vector<RunEdge> &run) {
+        std::string name = (std::filesystem::path(temp_directory) / "kruskal_run_XXXXXX").string();
+        const int fd = ::mkstemp(name.data());
+        if (fd < 0) {
+            throw std::runtime_error("Unable to create run file in: " + temp_directory);
+        }
+        ::close(fd);
+        runs.push_back(name);
+
+        std::ofstream file(name, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char *>(run.data()),
+                   static_cast<std::streamsize>(run.size() * sizeof(RunEdge)));
+        if (!file.good()) {
+            throw std::runtime_error("Unable to write run file: " + name);
+        }
+        run.clear();
+    }
+
+    // LSD radix sort on the run edges themselves, so the run needs one buffer of the same size and no index
+    // permutation. Edges enter the run in index order and every pass is stable, which keeps ties in index order.
+    void ExternalKruskal::sort_run(std::vector<RunEdge> &run, std::vector<RunEdge> &buffer) {
+        peak_run_memory = std::max(peak_run_memory, (run.capacity() + buffer.capacity()) * sizeof(RunEdge));
+        const size_t n = run.size();
+        if (n < small_sort_size) {
+            std::sort(run.begin(), run.end(), [](const RunEdge &a, const RunEdge &b) {
+                return a.key < b.key || (a.key == b.key && a.index < b.index);
+            });
+            return;
+        }
+
+        buffer.resize(n);
+        for (int shift = 0; shift < 64; shift += digit_bits) {
+            std::array<size_t, radix> counts{};
+            for (const RunEdge &edge: run) {
+                counts[edge.key >> shift & (radix - 1)]++;
+            }
+            if (counts[run[0].key >> shift & (radix - 1)] == n) {
+                continue;
+            }
+
+            size_t offset = 0;
+            for (size_t &count: counts) {
+                const size_t bucket_size = count;
+                count = offset;
+                offset += bucket_size;
+            }
+            for (const RunEdge &edge: run) {
+                buffer[counts[edge.key >> shift & (radix - 1)]++] = edge;
+            }
+            run.swap(buffer);
+        }
+    }
+
+    void ExternalKruskal::make_runs(std::vector<RunEdge> &run) {
+        EdgeReader reader(file_path);
+        points_size = reader.points_size;
+        edges_size = reader.edges_size;
+
+        // The run and its sort buffer are the only buffers that grow with the run.
+        const size_t run_size = std::max<size_t>(1, memory_budget / (2 * sizeof(RunEdge)));
+        const size_t reserved = std::min(run_size, edges_size);
+        std::vector<RunEdge> buffer;
+        run.reserve(reserved);
+        buffer.reserve(reserved);
+
+        for (size_t i = 0; i < edges_size; i++) {
+            uint64_t first, second;
+            double weight;
+            reader.next(first, second, weight);
+            if (first >= points_size || second >= points_size) {
+                throw std::runtime_error("Edge index out of range: (" + std::to_string(first) + ", " +
+                                         std::to_string(second) + ") with " + std::to_string(points_size) +
+                                         " points");
+            }
+            run.push_back({weight_key(weight), i, first, second});
+            if (run.size() == run_size) {
+                sort_run(run, buffer);
+                spill_run(run);
+            }
+        }
+
+        if (!run.empty()) {
+            sort_run(run, buffer);
+            if (!runs.empty()) {
+                spill_run(run);
+            }
+        }
+        // The merge gives the whole budget to its read buffers, so a spilled run must not stay allocated next to them.
+        if (!runs.empty()) {
+            std::vector<RunEdge>().swap(run);
+        }
+    }
+
+    void ExternalKruskal::merge_runs(std::vector<Edge> &mst, OperationCounts &counts) const {
+        using Head = std::pair<std::pair<uint64_t, uint64_t>, size_t>;
+
+        const size_t buffer_size = std::max(min_run_buffer_bytes, memory_budget / std::max<size_t>(1, runs.size())) /
+                                   sizeof(RunEdge);
+        std::vector<RunReader<RunEdge> > readers;
+        readers.reserve(runs.size());
+        std::vector<RunEdge> heads(runs.size());
+        std::priority_queue<Head, std::vector<Head>, std::greater<> > queue;
+        for (size_t i = 0; i < runs.size(); i++) {
+            readers.emplace_back(runs[i], buffer_size);
+            if (readers[i].next(heads[i])) {
+                queue.push({{heads[i].key, heads[i].index}, i});
+            }
+        }
+
+        UnionFind<FindPolicy::Compression, UnionPolicy::Rank, OperationCounter> uf(points_size);
+        while (!queue.empty() && mst.size() + 1 < points_size) {
+            const size_t run = queue.top().second;
+            queue.pop();
+            uf.get_counter().scan();
+            const RunEdge &edge = heads[run];
+            const size_t index1 = uf.find(edge.first);
+            const size_t index2 = uf.find(edge.second);
+            if (index1 != index2) {
+                mst.emplace_back(edge.first, edge.second, key_weight(edge.key));
+                uf.unite(index1, index2);
+            }
+            if (readers[run].next(heads[run])) {
+                queue.push({{heads[run].key, heads[run].index}, run});
+            }
+        }
+        counts = uf.get_counts();
+    }
+
+    std::vector<Edge> ExternalKruskal::get_MST(MSTMetrics &metrics, const bool hardware_counters) {
+        remove_runs();
+        peak_run_memory = 0;
+        metrics = {};
+        PhaseRecorder recorder(hardware_counters);
+        std::vector<Edge> mst;
+        std::vector<RunEdge> run;
+        OperationCounts counts;
+
+        recorder.begin();
+        make_runs(run);
+        recorder.end(metrics.sort);
+
+        recorder.begin();
+        if (runs.empty()) {
+            UnionFind<FindPolicy::Compression, UnionPolicy::Rank, OperationCounter> uf(points_size);
+            for (size_t i = 0; i < run.size() && mst.size() + 1 < points_size; i++) {
+                uf.get_counter().scan();
+                const size_t index1 = uf.find(run[i].first);
+                const size_t index2 = uf.find(run[i].second);
+                if (index1 != index2) {
+                    mst.emplace_back(run[i].first, run[i].second, key_weight(run[i].key));
+                    uf.unite(index1, index2);
+                }
+            }
+            counts = uf.get_counts();
+        } else {
+            merge_runs(mst, counts);
+        }
+        recorder.end(metrics.loop);
+
+        metrics.finds = counts.finds;
+        metrics.compression_hops = counts.hops;
+        metrics.unions = counts.unions;
+        metrics.edges_scanned = counts.scans;
+        metrics.peak_memory = peak_memory_usage();
+        metrics.scratch_memory = peak_run_memory;
+
+        remove_runs();
+        return mst;
+    }
+}
@@ -0,0 +1,57 @@
+#ifndef EXTERNALKRUSKAL_H
+#define EXTERNALKRUSKAL_H
+#include "Point.h"
+#include "Metrics.h"
+#include "UnionFind.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace GraphLib {
+    class ExternalKruskal {
+        struct RunEdge {
+            uint64_t key;
+            uint64_t index;
+            uint64_t first, second;
+        };
+
+        std::string file_path;
+        std::string temp_directory;
+        size_t memory_budget;
+
+        std::vector<std::string> runs;
+        size_t points_size;
+        size_t edges_size;
+        size_t peak_run_memory;
+
+        void sort_run(std::vector<RunEdge> &run, std::vector<RunEdge> &buffer);
+
+        void make_runs(std::vector<RunEdge> &run);
+
+        void spill_run(std::vector<RunEdge> &run);
+
+        void merge_runs(std::vector<Edge> &mst, OperationCounts &counts) const;
+
+        void remove_runs();
+
+    public:
+        static constexpr size_t default_memory_budget = 256 << 20;
+
+        explicit ExternalKruskal(const std::string &file_path, size_t memory_budget = default_memory_budget,
+                                 const std::string &temp_directory = "");
+
+        ExternalKruskal(const ExternalKruskal &) = delete;
+
+        ExternalKruskal &operator=(const ExternalKruskal &) = delete;
+
+        ~ExternalKruskal();
+
+        size_t get_runs_size() const;
+
+        size_t get_peak_run_memory() const;
+
+        std::vector<Edge> get_MST(MSTMetrics &metrics, bool hardware_counters = false);
+    };
+}
+
+#endif
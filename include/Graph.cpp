@@ -1,317 +1,1426 @@
 #include "Graph.h"
+#include "ConcurrentUnionFind.h"
+#include "GraphWriter.h"
+#include "KdTree.h"
+#include "MappedFile.h"
+#include "Parallel.h"
+#include "RadixSort.h"
+#include "Renderer.h"
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <numbers>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
 
 namespace GraphLib {
-    Graph::Graph(const std::string &file_path) {
-        try {
-            load_from_file(file_path);
-        } catch (const std::exception &ex) {
-            throw ex;
+    namespace {
+        constexpr size_t min_chunk_bytes = 1 << 20;
+
+        bool is_space(const char c) {
+            return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+        }
+
+        const char *skip_spaces(const char *first, const char *last) {
+            while (first < last && is_space(*first)) {
+                first++;
+            }
+            return first;
+        }
+
+        template<typename T>
+        const char *parse_value(const char *first, const char *last, T &value) {
+            first = skip_spaces(first, last);
+            const auto [ptr, ec] = std::from_chars(first, last, value);
+            if (ec != std::errc()) {
+                throw std::runtime_error("Malformed graph file near: \"" +
+                                         std::string(first, std::min<size_t>(16, last - first)) + "\"");
+            }
+            return ptr;
+        }
+
+        struct EdgeChunk {
+            const char *first, *last;
+            std::vector<size_t> u, v;
+            std::vector<double> w;
+            std::exception_ptr error;
+        };
+
+        void parse_edge_chunk(EdgeChunk &chunk, const size_t points_size) {
+            try {
+                const size_t estimate = static_cast<size_t>(chunk.last - chunk.first) / 16;
+                chunk.u.reserve(estimate);
+                chunk.v.reserve(estimate);
+                chunk.w.reserve(estimate);
+
+                const char *ptr = skip_spaces(chunk.first, chunk.last);
+                while (ptr < chunk.last) {
+                    size_t index1, index2;
+                    double weight;
+                    ptr = parse_value(ptr, chunk.last, index1);
+                    ptr = parse_value(ptr, chunk.last, index2);
+                    ptr = parse_value(ptr, chunk.last, weight);
+                    if (index1 >= points_size || index2 >= points_size) {
+                        throw std::runtime_error("Edge index out of range: (" + std::to_string(index1) + ", " +
+                                                 std::to_string(index2) + ") with " + std::to_string(points_size) +
+                                                 " points");
+                    }
+                    chunk.u.push_back(index1);
+                    chunk.v.push_back(index2);
+                    chunk.w.push_back(weight);
+                    ptr = skip_spaces(ptr, chunk.last);
+                }
+            } catch (...) {
+                chunk.error = std::current_exception();
+            }
+        }
+    }
+
+    namespace {
+        constexpr size_t filter_base_size = 1024;
+        constexpr size_t max_cache_entries = 16;
+        constexpr size_t no_edge = static_cast<size_t>(-1);
+        constexpr uint64_t no_key = static_cast<uint64_t>(-1);
+        constexpr size_t unseen = static_cast<size_t>(-1);
+        constexpr size_t done = static_cast<size_t>(-2);
+
+        bool item_less(const SortItem &a, const SortItem &b) {
+            return a.key < b.key || (a.key == b.key && a.index < b.index);
+        }
+
+        template<typename Body>
+        void dispatch_union_find(const MSTOptions &options, const size_t n, UnionFindStorage &storage, Body &&body) {
+            const auto with_counter = [&]<FindPolicy Find, UnionPolicy Union>() {
+                if (options.count_operations) {
+                    UnionFind<Find, Union, OperationCounter> uf(n, std::move(storage));
+                    body(uf);
+                    storage = uf.release();
+                } else {
+                    UnionFind<Find, Union, NoCounter> uf(n, std::move(storage));
+                    body(uf);
+                    storage = uf.release();
+                }
+            };
+            const auto with_union = [&]<FindPolicy Find>() {
+                switch (options.union_policy) {
+                    case UnionPolicy::Naive:
+                        with_counter.template operator()<Find, UnionPolicy::Naive>();
+                        break;
+                    case UnionPolicy::Rank:
+                        with_counter.template operator()<Find, UnionPolicy::Rank>();
+                        break;
+                    case UnionPolicy::Size:
+                        with_counter.template operator()<Find, UnionPolicy::Size>();
+                        break;
+                }
+            };
+            switch (options.find_policy) {
+                case FindPolicy::None:
+                    with_union.template operator()<FindPolicy::None>();
+                    break;
+                case FindPolicy::Compression:
+                    with_union.template operator()<FindPolicy::Compression>();
+                    break;
+                case FindPolicy::Halving:
+                    with_union.template operator()<FindPolicy::Halving>();
+                    break;
+                case FindPolicy::Splitting:
+                    with_union.template operator()<FindPolicy::Splitting>();
+                    break;
+            }
+        }
+
+        void add_counts(MSTMetrics &metrics, const OperationCounts &counts) {
+            metrics.finds += counts.finds;
+            metrics.compression_hops += counts.hops;
+            metrics.unions += counts.unions;
+            metrics.edges_scanned += counts.scans;
+        }
+
+        template<typename UF>
+        bool kruskal_step(UF &uf, const size_t edge, const std::span<const size_t> u, const std::span<const size_t> v,
+                          const size_t mst_size, std::vector<size_t> &mst) {
+            uf.get_counter().scan();
+            const size_t index1 = uf.find(u[edge]);
+            const size_t index2 = uf.find(v[edge]);
+            if (index1 != index2) {
+                mst.push_back(edge);
+                uf.unite(index1, index2);
+            }
+            return mst.size() == mst_size;
+        }
+
+        template<typename UF>
+        void kruskal_loop(UF &uf, const std::span<const size_t> sorted_edges, const std::span<const size_t> u,
+                          const std::span<const size_t> v, const size_t mst_size, std::vector<size_t> &mst) {
+            for (const size_t edge: sorted_edges) {
+                if (kruskal_step(uf, edge, u, v, mst_size, mst)) {
+                    break;
+                }
+            }
+        }
+
+        bool item_greater(const SortItem &a, const SortItem &b) {
+            return item_less(b, a);
+        }
+
+        template<typename UF>
+        void lazy_kruskal(std::vector<SortItem> &heap, const std::span<const size_t> u,
+                          const std::span<const size_t> v, const size_t mst_size, UF &uf, std::vector<size_t> &mst) {
+            while (!heap.empty()) {
+                std::pop_heap(heap.begin(), heap.end(), item_greater);
+                const size_t edge = heap.back().index;
+                heap.pop_back();
+                if (kruskal_step(uf, edge, u, v, mst_size, mst)) {
+                    return;
+                }
+            }
+        }
+
+        template<typename UF>
+        void filter_kruskal(std::span<SortItem> items, const std::span<const size_t> u, const std::span<const size_t> v,
+                            const size_t mst_size, UF &uf, std::vector<size_t> &mst) {
+            if (items.size() <= filter_base_size) {
+                std::sort(items.begin(), items.end(), item_less);
+                for (const SortItem &item: items) {
+                    if (kruskal_step(uf, item.index, u, v, mst_size, mst)) {
+                        return;
+                    }
+                }
+                return;
+            }
+
+            const SortItem first = items.front(), middle = items[items.size() / 2], last = items.back();
+            const SortItem pivot = item_less(first, middle)
+                                       ? (item_less(middle, last) ? middle : item_less(first, last) ? last : first)
+                                       : (item_less(first, last) ? first : item_less(middle, last) ? last : middle);
+            const auto heavy = std::partition(items.begin(), items.end(), [&pivot](const SortItem &item) {
+                return item_less(item, pivot);
+            });
+            const auto light_size = static_cast<size_t>(heavy - items.begin());
+
+            filter_kruskal(items.first(light_size), u, v, mst_size, uf, mst);
+            if (mst.size() == mst_size) {
+                return;
+            }
+
+            const auto kept = std::remove_if(heavy, items.end(), [&](const SortItem &item) {
+                return uf.find(u[item.index]) == uf.find(v[item.index]);
+            });
+            filter_kruskal(items.subspan(light_size, static_cast<size_t>(kept - heavy)), u, v, mst_size, uf, mst);
+        }
+
+        // Rough per-operation costs in nanoseconds behind MSTEngine::Auto, taken from the benchmark target. Work over
+        // arrays that stay in cache is several times cheaper, so edge-indexed and point-indexed work each have a
+        // second, cached price below these sizes. Only the ratios matter.
+        constexpr size_t cached_edges_limit = 1 << 14;
+        constexpr size_t cached_points_limit = 1 << 12;
+
+        struct EdgeCosts {
+            double sort_pass, adjacency_build, relax;
+        };
+
+        struct PointCosts {
+            double find, heap;
+        };
+
+        constexpr EdgeCosts edge_costs{15.0, 50.0, 10.0}, cached_edge_costs{4.0, 15.0, 5.0};
+        constexpr PointCosts point_costs{100.0, 100.0}, cached_point_costs{15.0, 15.0};
+        // A heap relaxation may also sift the point up, a dense scan slot is only overwritten.
+        constexpr double heap_relax_factor = 1.5;
+        constexpr double scan_cost = 2.0;
+        constexpr size_t weight_samples = 4096;
+
+        // Radix passes the sort will make, judged from an even sample of the weights: one histogram pass plus one per
+        // key byte that varies. Narrow or integral weight ranges leave most bytes constant.
+        double sort_passes(const std::span<const double> weights) {
+            if (weights.empty()) {
+                return 0.0;
+            }
+            const size_t stride = std::max<size_t>(1, weights.size() / weight_samples);
+            const uint64_t first = weight_key(weights[0]);
+            uint64_t varying = 0;
+            for (size_t i = 0; i < weights.size(); i += stride) {
+                varying |= weight_key(weights[i]) ^ first;
+            }
+            double passes = 1.0;
+            for (int byte = 0; byte < 8; byte++) {
+                passes += (varying >> (8 * byte) & 0xFF) != 0 ? 1.0 : 0.0;
+            }
+            return passes;
+        }
+
+        // Points are ordered by their cheapest known connecting edge as (weight key, edge index), the same total order
+        // the Kruskal engines use, so every engine returns the same tree.
+        bool lighter_link(const uint64_t key1, const size_t edge1, const uint64_t key2, const size_t edge2) {
+            return key1 < key2 || (key1 == key2 && edge1 < edge2);
+        }
+
+        // Indexed 4-ary min-heap of points. positions[p] is p's slot, unseen before it is pushed and done once popped.
+        class PointHeap {
+            static constexpr size_t arity = 4;
+
+            std::vector<size_t> &heap, &positions;
+            const std::vector<uint64_t> &keys;
+            const std::vector<size_t> &edges;
+
+            bool less(const size_t a, const size_t b) const {
+                return lighter_link(keys[a], edges[a], keys[b], edges[b]);
+            }
+
+            void place(const size_t slot, const size_t point) {
+                heap[slot] = point;
+                positions[point] = slot;
+            }
+
+            void sift_up(size_t slot) {
+                const size_t point = heap[slot];
+                while (slot > 0) {
+                    const size_t parent = (slot - 1) / arity;
+                    if (!less(point, heap[parent])) {
+                        break;
+                    }
+                    place(slot, heap[parent]);
+                    slot = parent;
+                }
+                place(slot, point);
+            }
+
+            void sift_down(size_t slot) {
+                const size_t point = heap[slot];
+                while (true) {
+                    const size_t first = slot * arity + 1;
+                    if (first >= heap.size()) {
+                        break;
+                    }
+                    size_t best = first;
+                    for (size_t child = first + 1; child < std::min(first + arity, heap.size()); child++) {
+                        if (less(heap[child], heap[best])) {
+                            best = child;
+                        }
+                    }
+                    if (!less(heap[best], point)) {
+                        break;
+                    }
+                    place(slot, heap[best]);
+                    slot = best;
+                }
+                place(slot, point);
+            }
+
+        public:
+            PointHeap(std::vector<size_t> &heap, std::vector<size_t> &positions, const std::vector<uint64_t> &keys,
+                      const std::vector<size_t> &edges) : heap(heap), positions(positions), keys(keys), edges(edges) {
+                heap.clear();
+            }
+
+            bool empty() const {
+                return heap.empty();
+            }
+
+            // Call after lowering the point's key.
+            void update(const size_t point) {
+                if (positions[point] == unseen) {
+                    heap.push_back(point);
+                    positions[point] = heap.size() - 1;
+                }
+                sift_up(positions[point]);
+            }
+
+            size_t pop() {
+                const size_t top = heap.front();
+                positions[top] = done;
+                const size_t last = heap.back();
+                heap.pop_back();
+                if (!heap.empty()) {
+                    place(0, last);
+                    sift_down(0);
+                }
+                return top;
+            }
+        };
+    }
+
+    size_t MSTScratch::capacity_bytes() const {
+        size_t bytes = sort_buffer.capacity() * sizeof(SortItem);
+        for (const std::vector<size_t> *buffer: {
+                 &sorted_edges, &union_find.parent, &union_find.rank, &components, &best_edges, &chunk_sizes, &mst
+             }) {
+            bytes += buffer->capacity() * sizeof(size_t);
         }
+        for (const std::vector<size_t> &buffer: selected) {
+            bytes += buffer.capacity() * sizeof(size_t);
+        }
+        bytes += adjacency.capacity_bytes() + prim_keys.capacity() * sizeof(uint64_t) +
+                (prim_heap.capacity() + prim_positions.capacity()) * sizeof(size_t);
+        return bytes;
     }
 
-    Graph::~Graph() {
-        points.clear();
-        edges.clear();
+    Graph::Graph(const std::string &file_path, const unsigned load_threads) {
+        PhaseRecorder recorder;
+        recorder.begin();
+        auto file = std::make_unique<MappedFile>(file_path);
+        if (file->size() >= sizeof(BinaryHeader) &&
+            std::memcmp(file->begin(), BinaryHeader::magic_value, sizeof(BinaryHeader::magic_value)) == 0) {
+            load_from_binary(std::move(file), file_path);
+        } else {
+            file.reset();
+            load_from_file(file_path, load_threads);
+            attach_storage();
+        }
+        recorder.end(load_metrics);
     }
 
-    void Graph::load_from_file(const std::string &file_path) {
-        std::ifstream file(file_path);
-        if (!file.is_open()) {
-            throw std::runtime_error("Unable to open file from: " + file_path);
+    Graph::Graph(std::vector<double> x, std::vector<double> y, std::vector<size_t> u, std::vector<size_t> v,
+                 std::vector<double> w) {
+        if (x.size() != y.size()) {
+            throw std::runtime_error("Point coordinate arrays differ in size: " + std::to_string(x.size()) + " and " +
+                                     std::to_string(y.size()));
+        }
+        if (u.size() != w.size() || v.size() != w.size()) {
+            throw std::runtime_error("Edge arrays differ in size: " + std::to_string(u.size()) + ", " +
+                                     std::to_string(v.size()) + " and " + std::to_string(w.size()));
+        }
+        for (size_t i = 0; i < w.size(); i++) {
+            if (u[i] >= x.size() || v[i] >= x.size()) {
+                throw std::runtime_error("Edge index out of range: (" + std::to_string(u[i]) + ", " +
+                                         std::to_string(v[i]) + ") with " + std::to_string(x.size()) + " points");
+            }
+        }
+        storage.x = std::move(x);
+        storage.y = std::move(y);
+        storage.u = std::move(u);
+        storage.v = std::move(v);
+        storage.w = std::move(w);
+        attach_storage();
+    }
+
+    void Graph::attach_storage() {
+        x = storage.x;
+        y = storage.y;
+        u = storage.u;
+        v = storage.v;
+        w = storage.w;
+    }
+
+    void Graph::detach_mapping() {
+        if (!mapping) {
+            return;
+        }
+        storage.x.assign(x.begin(), x.end());
+        storage.y.assign(y.begin(), y.end());
+        storage.u.assign(u.begin(), u.end());
+        storage.v.assign(v.begin(), v.end());
+        storage.w.assign(w.begin(), w.end());
+        if (!sorted.empty()) {
+            const std::lock_guard lock(cache->mutex);
+            cache->sorted_edges = std::make_shared<const std::vector<size_t> >(sorted.begin(), sorted.end());
         }
+        sorted = {};
+        mapping.reset();
+        attach_storage();
+    }
+
+    void Graph::invalidate_cache(const bool edges_changed) {
+        const std::lock_guard lock(cache->mutex);
+        cache->entries.clear();
+        // The adjacency index has a row per point, so a new point outdates it as much as a new edge does.
+        cache->adjacency.reset();
+        if (edges_changed) {
+            cache->sorted_edges.reset();
+        }
+    }
+
+    std::shared_ptr<const std::vector<size_t> > Graph::get_cached_sorted_edges(const MSTOptions &options) const {
+        if (options.use_cache) {
+            const std::lock_guard lock(cache->mutex);
+            if (cache->sorted_edges) {
+                cache->stats.sorted_hits++;
+                return cache->sorted_edges;
+            }
+            cache->stats.sorted_misses++;
+        }
+
+        auto sorted_edges = std::make_shared<const std::vector<size_t> >(
+            get_sorted_edges(options.sort_mode, options.threads));
+        if (options.use_cache) {
+            const std::lock_guard lock(cache->mutex);
+            cache->sorted_edges = sorted_edges;
+        }
+        return sorted_edges;
+    }
+
+    std::shared_ptr<const AdjacencyIndex> Graph::get_adjacency() const {
+        {
+            const std::lock_guard lock(cache->mutex);
+            if (cache->adjacency) {
+                cache->stats.adjacency_hits++;
+                return cache->adjacency;
+            }
+            cache->stats.adjacency_misses++;
+        }
+
+        auto adjacency = std::make_shared<AdjacencyIndex>();
+        adjacency->build(x.size(), u, v, w);
+        const std::lock_guard lock(cache->mutex);
+        cache->adjacency = adjacency;
+        return adjacency;
+    }
+
+    const AdjacencyIndex &Graph::resolve_adjacency(const MSTOptions &options, MSTScratch &scratch,
+                                                   std::shared_ptr<const AdjacencyIndex> &cached) const {
+        if (options.use_cache) {
+            cached = get_adjacency();
+            return *cached;
+        }
+        scratch.adjacency.build(x.size(), u, v, w);
+        return scratch.adjacency;
+    }
+
+    void Graph::load_from_file(const std::string &file_path, unsigned load_threads) {
+        const MappedFile file(file_path);
+        const char *ptr = file.begin();
+        const char *last = file.end();
 
         size_t points_size{}, edges_size{};
 
-        file >> points_size;
+        ptr = parse_value(ptr, last, points_size);
+        storage.x.reserve(points_size);
+        storage.y.reserve(points_size);
         for (size_t i = 0; i < points_size; i++) {
-            double x, y;
-            file >> x >> y;
-            add_point(x, y, i);
+            double px, py;
+            ptr = parse_value(ptr, last, px);
+            ptr = parse_value(ptr, last, py);
+            storage.x.push_back(px);
+            storage.y.push_back(py);
         }
 
-        file >> edges_size;
-        for (size_t i = 0; i < edges_size; i++) {
-            int index1, index2;
-            double weight;
-            file >> index1 >> index2 >> weight;
-            make_pair(points[index1], points[index2], weight);
+        ptr = skip_spaces(ptr, last);
+        if (ptr == last) {
+            return;
         }
+        ptr = parse_value(ptr, last, edges_size);
 
-        file.close();
-    }
+        if (load_threads == 0) {
+            load_threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        const auto bytes = static_cast<size_t>(last - ptr);
+        const size_t chunks_size = std::clamp<size_t>(bytes / min_chunk_bytes, 1, load_threads);
 
-    void Graph::add_point(const double x, const double y, const size_t index) {
-        points.push_back(new Point(x, y, index));
+        std::vector<EdgeChunk> chunks(chunks_size);
+        for (size_t i = 0; i < chunks_size; i++) {
+            const char *chunk_first = i == 0 ? ptr : chunks[i - 1].last;
+            const char *chunk_last = i + 1 == chunks_size ? last : std::max(chunk_first, ptr + bytes * (i + 1) / chunks_size);
+            if (chunk_last < last) {
+                const void *newline = std::memchr(chunk_last, '\n', static_cast<size_t>(last - chunk_last));
+                chunk_last = newline != nullptr ? static_cast<const char *>(newline) + 1 : last;
+            }
+            chunks[i].first = chunk_first;
+            chunks[i].last = chunk_last;
+        }
+
+        std::vector<std::thread> workers;
+        for (size_t i = 1; i < chunks_size; i++) {
+            workers.emplace_back(parse_edge_chunk, std::ref(chunks[i]), points_size);
+        }
+        parse_edge_chunk(chunks[0], points_size);
+        for (std::thread &worker: workers) {
+            worker.join();
+        }
+
+        size_t parsed_size = 0;
+        for (const EdgeChunk &chunk: chunks) {
+            if (chunk.error) {
+                std::rethrow_exception(chunk.error);
+            }
+            parsed_size += chunk.w.size();
+        }
+        if (parsed_size != edges_size) {
+            throw std::runtime_error("Expected " + std::to_string(edges_size) + " edges, found " +
+                                     std::to_string(parsed_size) + " in: " + file_path);
+        }
+
+        if (chunks_size == 1) {
+            storage.u = std::move(chunks[0].u);
+            storage.v = std::move(chunks[0].v);
+            storage.w = std::move(chunks[0].w);
+            return;
+        }
+
+        storage.u.resize(edges_size);
+        storage.v.resize(edges_size);
+        storage.w.resize(edges_size);
+        workers.clear();
+        size_t offset = 0;
+        for (EdgeChunk &chunk: chunks) {
+            workers.emplace_back([this, &chunk, offset] {
+                std::copy(chunk.u.begin(), chunk.u.end(), storage.u.begin() + static_cast<std::ptrdiff_t>(offset));
+                std::copy(chunk.v.begin(), chunk.v.end(), storage.v.begin() + static_cast<std::ptrdiff_t>(offset));
+                std::copy(chunk.w.begin(), chunk.w.end(), storage.w.begin() + static_cast<std::ptrdiff_t>(offset));
+            });
+            offset += chunk.w.size();
+        }
+        for (std::thread &worker: workers) {
+            worker.join();
+        }
     }
 
-    void Graph::make_pair(Point *first, Point *second, const double weight) {
-        edges.push_back(new Pair(first, second, weight));
+    void Graph::load_from_binary(std::unique_ptr<MappedFile> file, const std::string &file_path) {
+        static_assert(sizeof(size_t) == sizeof(uint64_t), "binary graphs map edge indices as size_t");
+
+        BinaryHeader header{};
+        std::memcpy(&header, file->begin(), sizeof(BinaryHeader));
+        if (header.byte_order != BinaryHeader::byte_order_value) {
+            throw std::runtime_error("Binary graph has foreign byte order: " + file_path);
+        }
+
+        const auto fits = [&](const uint64_t offset, const uint64_t count, const uint64_t element_size) {
+            return offset % alignof(uint64_t) == 0 && offset <= file->size() &&
+                   count <= (file->size() - offset) / element_size;
+        };
+        if (!fits(header.x_offset, header.points_size, sizeof(double)) ||
+            !fits(header.y_offset, header.points_size, sizeof(double)) ||
+            !fits(header.u_offset, header.edges_size, sizeof(uint64_t)) ||
+            !fits(header.v_offset, header.edges_size, sizeof(uint64_t)) ||
+            !fits(header.w_offset, header.edges_size, sizeof(double)) ||
+            (header.flags & BinaryHeader::sorted_flag &&
+             !fits(header.sorted_offset, header.edges_size, sizeof(uint64_t)))) {
+            throw std::runtime_error("Truncated binary graph file: " + file_path);
+        }
+
+        const char *base = file->begin();
+        x = {reinterpret_cast<const double *>(base + header.x_offset), header.points_size};
+        y = {reinterpret_cast<const double *>(base + header.y_offset), header.points_size};
+        u = {reinterpret_cast<const size_t *>(base + header.u_offset), header.edges_size};
+        v = {reinterpret_cast<const size_t *>(base + header.v_offset), header.edges_size};
+        w = {reinterpret_cast<const double *>(base + header.w_offset), header.edges_size};
+        if (header.flags & BinaryHeader::sorted_flag) {
+            sorted = {reinterpret_cast<const size_t *>(base + header.sorted_offset), header.edges_size};
+        }
+
+        // The sections are used without bounds checks later on, so one pass over the indices rejects a corrupt file
+        // here, as parse_edge_chunk does for text graphs.
+        for (size_t i = 0; i < u.size(); i++) {
+            if (u[i] >= header.points_size || v[i] >= header.points_size) {
+                throw std::runtime_error("Edge index out of range: (" + std::to_string(u[i]) + ", " +
+                                         std::to_string(v[i]) + ") with " + std::to_string(header.points_size) +
+                                         " points in " + file_path);
+            }
+        }
+        for (const size_t edge: sorted) {
+            if (edge >= header.edges_size) {
+                throw std::runtime_error("Sorted edge index out of range: " + std::to_string(edge) + " with " +
+                                         std::to_string(header.edges_size) + " edges in " + file_path);
+            }
+        }
+        mapping = std::move(file);
     }
 
-    std::vector<Pair *> Graph::get_sorted_edges() const {
-        const size_t n = edges.size();
-        std::vector<Pair *> sorted_edges;
-        auto *buckets = new std::vector<Pair *>[n];
+    void Graph::build_euclidean_edges(const unsigned threads) {
+        detach_mapping();
+        sorted = {};
+        invalidate_cache(true);
+        incremental.reset();
+        storage.u.clear();
+        storage.v.clear();
+        storage.w.clear();
+
+        struct Candidate {
+            double distance;
+            size_t first, second;
+
+            bool operator<(const Candidate &other) const {
+                return distance < other.distance || (distance == other.distance &&
+                                                     (first < other.first ||
+                                                      (first == other.first && second < other.second)));
+            }
+        };
 
+        const size_t n = x.size();
+        KdTree tree(x, y);
+        UnionFind<> uf(n);
+        std::vector<size_t> component(n), nearest(n, KdTree::no_point);
+        std::vector<double> nearest_distance(n, 0.0);
         for (size_t i = 0; i < n; i++) {
-            auto bucket_index = static_cast<size_t>(edges[i]->weight * static_cast<double>(n) / 1);
-            buckets[bucket_index].push_back(edges[i]);
+            component[i] = i;
         }
+        const Candidate none{std::numeric_limits<double>::infinity(), KdTree::no_point, KdTree::no_point};
+        std::vector<Candidate> best(n, none);
 
-        for (size_t i = 0; i < n; i++) {
-            if (!buckets[i].empty()) {
-                for (size_t j = 1; j < buckets[i].size(); j++) {
-                    Pair *key = buckets[i][j];
-                    size_t k = j - 1;
-
-                    while (k < buckets[i].size() && buckets[i][k]->weight > key->weight) {
-                        buckets[i][k + 1] = buckets[i][k];
-                        k--;
+        const auto workers = static_cast<unsigned>(std::clamp<size_t>(n, 1, resolve_threads(threads)));
+        std::vector<std::vector<std::pair<size_t, Candidate> > > found_candidates(workers);
+        std::vector<size_t> members(n), member_offsets(n + 1);
+        size_t components = n;
+        while (components > 1) {
+            tree.set_components(component);
+
+            std::fill(member_offsets.begin(), member_offsets.end(), 0);
+            for (size_t i = 0; i < n; i++) {
+                member_offsets[component[i] + 1]++;
+            }
+            for (size_t c = 0; c < n; c++) {
+                member_offsets[c + 1] += member_offsets[c];
+            }
+            for (const size_t point: tree.get_order()) {
+                members[member_offsets[component[point]]++] = point;
+            }
+            for (size_t c = n; c > 0; c--) {
+                member_offsets[c] = member_offsets[c - 1];
+            }
+            member_offsets[0] = 0;
+
+            parallel_for(workers, n, [&](const size_t first, const size_t last) {
+                for (size_t c = first; c < last; c++) {
+                    Candidate candidate = none;
+                    for (size_t i = member_offsets[c]; i < member_offsets[c + 1]; i++) {
+                        const size_t point = members[i];
+                        if (nearest[point] != KdTree::no_point && component[nearest[point]] != c) {
+                            candidate = std::min(candidate, Candidate{
+                                                     nearest_distance[point], std::min(point, nearest[point]),
+                                                     std::max(point, nearest[point])
+                                                 });
+                        } else {
+                            nearest[point] = KdTree::no_point;
+                        }
                     }
+                    best[c] = candidate;
+                }
+            });
 
-                    buckets[i][k + 1] = key;
+            parallel_run(workers, [&](const unsigned t) {
+                std::vector<std::pair<size_t, Candidate> > &found = found_candidates[t];
+                found.clear();
+                size_t c = KdTree::no_point;
+                Candidate candidate = none;
+                for (size_t i = n * t / workers; i < n * (t + 1) / workers; i++) {
+                    const size_t point = members[i];
+                    if (component[point] != c) {
+                        if (c != KdTree::no_point) {
+                            found.emplace_back(c, candidate);
+                        }
+                        c = component[point];
+                        candidate = best[c];
+                    }
+                    if (nearest[point] != KdTree::no_point || nearest_distance[point] > candidate.distance) {
+                        continue;
+                    }
+                    double distance = candidate.distance;
+                    const size_t neighbour = tree.nearest_foreign(x[point], y[point], c, distance);
+                    nearest_distance[point] = distance;
+                    if (neighbour != KdTree::no_point) {
+                        nearest[point] = neighbour;
+                        candidate = std::min(candidate, Candidate{
+                                                 distance, std::min(point, neighbour), std::max(point, neighbour)
+                                             });
+                    }
+                }
+                if (c != KdTree::no_point) {
+                    found.emplace_back(c, candidate);
+                }
+            });
+            for (const std::vector<std::pair<size_t, Candidate> > &found: found_candidates) {
+                for (const auto &[c, candidate]: found) {
+                    best[c] = std::min(best[c], candidate);
                 }
+            }
 
-                for (size_t j = 0; j < buckets[i].size(); j++) {
-                    sorted_edges.push_back(buckets[i][j]);
+            for (Candidate &candidate: best) {
+                if (candidate.first == KdTree::no_point) {
+                    continue;
+                }
+                const size_t index1 = uf.find(candidate.first);
+                const size_t index2 = uf.find(candidate.second);
+                if (index1 != index2) {
+                    uf.unite(index1, index2);
+                    storage.u.push_back(candidate.first);
+                    storage.v.push_back(candidate.second);
+                    storage.w.push_back(std::sqrt(candidate.distance));
+                    components--;
                 }
+                candidate = none;
+            }
+
+            for (size_t i = 0; i < n; i++) {
+                component[i] = uf.find(i);
+            }
+        }
+
+        attach_storage();
+    }
+
+    void Graph::save_binary(const std::string &file_path, const bool with_sorted_edges) const {
+        std::ofstream file(file_path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            throw std::runtime_error("Unable to open file from: " + file_path);
+        }
+
+        const auto aligned = [](const uint64_t offset) {
+            return (offset + BinaryHeader::alignment - 1) / BinaryHeader::alignment * BinaryHeader::alignment;
+        };
+
+        BinaryHeader header{};
+        std::memcpy(header.magic, BinaryHeader::magic_value, sizeof(header.magic));
+        header.byte_order = BinaryHeader::byte_order_value;
+        header.flags = with_sorted_edges ? BinaryHeader::sorted_flag : 0;
+        header.points_size = x.size();
+        header.edges_size = w.size();
+        header.x_offset = aligned(sizeof(BinaryHeader));
+        header.y_offset = aligned(header.x_offset + x.size() * sizeof(double));
+        header.u_offset = aligned(header.y_offset + y.size() * sizeof(double));
+        header.v_offset = aligned(header.u_offset + u.size() * sizeof(uint64_t));
+        header.w_offset = aligned(header.v_offset + v.size() * sizeof(uint64_t));
+        header.sorted_offset = with_sorted_edges ? aligned(header.w_offset + w.size() * sizeof(double)) : 0;
+
+        const auto write_at = [&file](const uint64_t offset, const void *data, const size_t bytes) {
+            static constexpr char padding[BinaryHeader::alignment]{};
+            const auto position = static_cast<uint64_t>(file.tellp());
+            file.write(padding, static_cast<std::streamsize>(offset - position));
+            file.write(static_cast<const char *>(data), static_cast<std::streamsize>(bytes));
+        };
+
+        file.write(reinterpret_cast<const char *>(&header), sizeof(BinaryHeader));
+        write_at(header.x_offset, x.data(), x.size_bytes());
+        write_at(header.y_offset, y.data(), y.size_bytes());
+        write_at(header.u_offset, u.data(), u.size_bytes());
+        write_at(header.v_offset, v.data(), v.size_bytes());
+        write_at(header.w_offset, w.data(), w.size_bytes());
+        if (with_sorted_edges) {
+            std::shared_ptr<const std::vector<size_t> > computed_edges;
+            if (sorted.empty()) {
+                computed_edges = get_cached_sorted_edges(MSTOptions{});
             }
+            const std::span<const size_t> sorted_edges = sorted.empty()
+                                                             ? std::span<const size_t>(*computed_edges)
+                                                             : sorted;
+            write_at(header.sorted_offset, sorted_edges.data(), sorted_edges.size_bytes());
+        }
+
+        if (!file.good()) {
+            throw std::runtime_error("Unable to write binary graph to: " + file_path);
         }
+    }
+
+    bool Graph::is_mapped() const {
+        return mapping != nullptr;
+    }
 
-        delete[] buckets;
+    void Graph::add_point(const double x, const double y) {
+        detach_mapping();
+        storage.x.push_back(x);
+        storage.y.push_back(y);
+        attach_storage();
+        invalidate_cache(false);
+        if (incremental) {
+            incremental->add_point();
+        }
+    }
+
+    size_t Graph::make_pair(const size_t first, const size_t second, const double weight) {
+        detach_mapping();
+        sorted = {};
+        storage.u.push_back(first);
+        storage.v.push_back(second);
+        storage.w.push_back(weight);
+        attach_storage();
+        invalidate_cache(true);
+        if (!incremental) {
+            return IncrementalMST::no_edge;
+        }
+        return incremental->add_edge(w.size() - 1, first, second, weight);
+    }
+
+    void Graph::track_MST(const MSTOptions &options) {
+        const std::vector<size_t> mst = get_MST(options);
+        incremental = std::make_unique<IncrementalMST>(x.size(), u, v, w, mst);
+    }
+
+    bool Graph::is_tracking_MST() const {
+        return incremental != nullptr;
+    }
+
+    size_t Graph::add_edge(const size_t first, const size_t second, const double weight) {
+        if (first >= x.size() || second >= x.size()) {
+            throw std::out_of_range("Edge index out of range: " + std::to_string(first) + " " +
+                                    std::to_string(second));
+        }
+        return make_pair(first, second, weight);
+    }
+
+    void Graph::add_edges(const std::vector<Edge> &edges) {
+        for (const Edge &edge: edges) {
+            if (edge.first >= x.size() || edge.second >= x.size()) {
+                throw std::out_of_range("Edge index out of range: " + std::to_string(edge.first) + " " +
+                                        std::to_string(edge.second));
+            }
+        }
+        detach_mapping();
+        storage.u.reserve(storage.u.size() + edges.size());
+        storage.v.reserve(storage.v.size() + edges.size());
+        storage.w.reserve(storage.w.size() + edges.size());
+        for (const Edge &edge: edges) {
+            make_pair(edge.first, edge.second, edge.weight);
+        }
+    }
+
+    std::vector<size_t> Graph::get_tracked_MST() const {
+        if (!incremental) {
+            throw std::logic_error("MST tracking is not enabled, call track_MST first");
+        }
+        return incremental->get_edges();
+    }
+
+    double Graph::get_tracked_MST_weight() const {
+        if (!incremental) {
+            throw std::logic_error("MST tracking is not enabled, call track_MST first");
+        }
+        return incremental->get_weight();
+    }
+
+    size_t Graph::points_size() const {
+        return x.size();
+    }
+
+    size_t Graph::edges_size() const {
+        return w.size();
+    }
+
+    Point Graph::get_point(const size_t index) const {
+        return {x[index], y[index], index};
+    }
+
+    Pair Graph::get_edge(const size_t index) const {
+        return {get_point(u[index]), get_point(v[index]), w[index]};
+    }
+
+    std::vector<Pair> Graph::to_pairs(const std::vector<size_t> &edge_indices) const {
+        std::vector<Pair> pairs;
+        pairs.reserve(edge_indices.size());
+        for (const size_t edge: edge_indices) {
+            pairs.push_back(get_edge(edge));
+        }
+        return pairs;
+    }
+
+    std::vector<size_t> Graph::get_sorted_edges(const SortMode sort_mode, const unsigned threads) const {
+        std::vector<SortItem> buffer;
+        std::vector<size_t> sorted_edges;
+        radix_sort_edges(w, buffer, sorted_edges, sort_mode == SortMode::ParallelRadix ? threads : 1);
         return sorted_edges;
     }
 
-    std::vector<Pair *> Graph::get_MST(const bool rank_unite, const bool path_compression,
+    std::vector<size_t> Graph::get_MST(const bool rank_unite, const bool path_compression,
                                        double &sort_time, double &loop_time,
                                        int &find_calls) const {
-        UnionFind uf(static_cast<int>(points.size()));
-        std::vector<Pair *> mst;
-
-        const auto start_sort_time = std::chrono::high_resolution_clock::now();
-        std::vector<Pair *> sorted_edges = get_sorted_edges();
-        const auto end_sort_time = std::chrono::high_resolution_clock::now();
-
-        const auto start_loop_time = std::chrono::high_resolution_clock::now();
-        switch (rank_unite) {
-            case true:
-                switch (path_compression) {
-                    case true:
-                        for (size_t i = 0; i < sorted_edges.size(); i++) {
-                            int index1 = uf.compress_find(static_cast<int>(sorted_edges[i]->first->index));
-                            int index2 = uf.compress_find(static_cast<int>(sorted_edges[i]->second->index));
-
-                            if (index1 != index2) {
-                                mst.push_back(sorted_edges[i]);
-                                uf.rank_unite(index1, index2);
-                                if (mst.size() == points.size() - 1) {
-                                    break;
-                                }
-                            }
-                        }
-                        break;
+        MSTOptions options;
+        options.find_policy = path_compression ? FindPolicy::Compression : FindPolicy::None;
+        options.union_policy = rank_unite ? UnionPolicy::Rank : UnionPolicy::Naive;
+        options.count_operations = true;
+        MSTMetrics metrics;
+        std::vector<size_t> mst = get_MST(options, metrics);
+        sort_time = metrics.sort.time;
+        loop_time = metrics.loop.time;
+        find_calls = static_cast<int>(std::min<uint64_t>(metrics.finds + metrics.compression_hops,
+                                                         std::numeric_limits<int>::max()));
+        return mst;
+    }
+
+    void Graph::get_filter_MST(const MSTOptions &options, PhaseRecorder &recorder,
+                               MSTMetrics &metrics, MSTScratch &scratch) const {
+        recorder.begin();
+        std::vector<SortItem> &items = scratch.sort_buffer;
+        items.resize(w.size());
+        for (size_t i = 0; i < w.size(); i++) {
+            items[i] = {weight_key(w[i]), i};
+        }
+        recorder.end(metrics.sort);
+
+        recorder.begin();
+        if (x.size() > 1) {
+            dispatch_union_find(options, x.size(), scratch.union_find, [&](auto &uf) {
+                filter_kruskal(std::span(items), u, v, x.size() - 1, uf, scratch.mst);
+                add_counts(metrics, uf.get_counts());
+            });
+        }
+        recorder.end(metrics.loop);
+    }
+
+    void Graph::get_lazy_MST(const MSTOptions &options, PhaseRecorder &recorder,
+                             MSTMetrics &metrics, MSTScratch &scratch) const {
+        recorder.begin();
+        std::vector<SortItem> &heap = scratch.sort_buffer;
+        heap.resize(w.size());
+        for (size_t i = 0; i < w.size(); i++) {
+            heap[i] = {weight_key(w[i]), i};
+        }
+        std::make_heap(heap.begin(), heap.end(), item_greater);
+        recorder.end(metrics.sort);
 
-                    case false:
-                        for (size_t i = 0; i < sorted_edges.size(); i++) {
-                            int index1 = uf.find(static_cast<int>(sorted_edges[i]->first->index));
-                            int index2 = uf.find(static_cast<int>(sorted_edges[i]->second->index));
-
-                            if (index1 != index2) {
-                                mst.push_back(sorted_edges[i]);
-                                uf.rank_unite(index1, index2);
-                                if (mst.size() == points.size() - 1) {
-                                    break;
-                                }
-                            }
+        recorder.begin();
+        if (x.size() > 1) {
+            dispatch_union_find(options, x.size(), scratch.union_find, [&](auto &uf) {
+                lazy_kruskal(heap, u, v, x.size() - 1, uf, scratch.mst);
+                add_counts(metrics, uf.get_counts());
+            });
+        }
+        recorder.end(metrics.loop);
+    }
+
+    void Graph::get_boruvka_MST(const MSTOptions &options, PhaseRecorder &recorder,
+                                MSTMetrics &metrics, MSTScratch &scratch) const {
+        ConcurrentUnionFind uf(x.size(), std::move(scratch.union_find.parent));
+        std::vector<size_t> &mst = scratch.mst;
+        const unsigned threads = resolve_threads(options.threads);
+        const auto lighter = [this](const size_t a, const size_t b) {
+            return w[a] < w[b] || (w[a] == w[b] && a < b);
+        };
+
+        recorder.begin();
+        std::vector<size_t> &component = scratch.components;
+        component.resize(x.size());
+        for (size_t i = 0; i < x.size(); i++) {
+            component[i] = i;
+        }
+        std::vector<size_t> &active = scratch.sorted_edges;
+        active.resize(w.size());
+        for (size_t i = 0; i < w.size(); i++) {
+            active[i] = i;
+        }
+        std::vector<size_t> &best_edges = scratch.best_edges;
+        best_edges.resize(x.size());
+        const auto best = [&best_edges](const size_t c) {
+            return std::atomic_ref(best_edges[c]);
+        };
+        std::vector<size_t> &chunk_sizes = scratch.chunk_sizes;
+        chunk_sizes.resize(threads);
+        std::vector<std::vector<size_t> > &selected = scratch.selected;
+        selected.resize(threads);
+
+        while (x.size() > 1 && mst.size() < x.size() - 1 && !active.empty()) {
+            std::fill(best_edges.begin(), best_edges.end(), no_edge);
+
+            parallel_for(threads, active.size(), [&](const size_t first, const size_t last) {
+                for (size_t i = first; i < last; i++) {
+                    const size_t edge = active[i];
+                    const size_t component1 = component[u[edge]], component2 = component[v[edge]];
+                    if (component1 == component2) {
+                        continue;
+                    }
+                    for (const size_t c: {component1, component2}) {
+                        size_t current = best(c).load(std::memory_order_relaxed);
+                        while ((current == no_edge || lighter(edge, current)) &&
+                               !best(c).compare_exchange_weak(current, edge, std::memory_order_relaxed)) {
                         }
-                        break;
+                    }
+                }
+            });
+
+            const size_t mst_size = mst.size();
+            const size_t components_size = std::clamp<size_t>(x.size(), 1, threads);
+            parallel_run(static_cast<unsigned>(components_size), [&](const unsigned t) {
+                selected[t].clear();
+                for (size_t c = x.size() * t / components_size; c < x.size() * (t + 1) / components_size; c++) {
+                    const size_t edge = best(c).load(std::memory_order_relaxed);
+                    if (edge != no_edge && uf.unite(u[edge], v[edge])) {
+                        selected[t].push_back(edge);
+                    }
                 }
+            });
+            for (size_t t = 0; t < components_size; t++) {
+                mst.insert(mst.end(), selected[t].begin(), selected[t].end());
+            }
+            if (mst.size() == mst_size) {
                 break;
+            }
 
-            case false:
-                switch (path_compression) {
-                    case true:
-                        for (size_t i = 0; i < sorted_edges.size(); i++) {
-                            int index1 = uf.compress_find(static_cast<int>(sorted_edges[i]->first->index));
-                            int index2 = uf.compress_find(static_cast<int>(sorted_edges[i]->second->index));
-
-                            if (index1 != index2) {
-                                mst.push_back(sorted_edges[i]);
-                                uf.unite(index1, index2);
-                                if (mst.size() == points.size() - 1) {
-                                    break;
-                                }
-                            }
-                        }
-                        break;
+            parallel_for(threads, x.size(), [&](const size_t first, const size_t last) {
+                for (size_t i = first; i < last; i++) {
+                    component[i] = uf.find(i);
+                }
+            });
 
-                    case false:
-                        for (size_t i = 0; i < sorted_edges.size(); i++) {
-                            int index1 = uf.find(static_cast<int>(sorted_edges[i]->first->index));
-                            int index2 = uf.find(static_cast<int>(sorted_edges[i]->second->index));
-
-                            if (index1 != index2) {
-                                mst.push_back(sorted_edges[i]);
-                                uf.unite(index1, index2);
-                                if (mst.size() == points.size() - 1) {
-                                    break;
-                                }
-                            }
-                        }
-                        break;
+            const size_t chunks_size = std::clamp<size_t>(active.size(), 1, threads);
+            parallel_run(static_cast<unsigned>(chunks_size), [&](const unsigned t) {
+                const size_t first = active.size() * t / chunks_size, last = active.size() * (t + 1) / chunks_size;
+                size_t kept = first;
+                for (size_t i = first; i < last; i++) {
+                    if (component[u[active[i]]] != component[v[active[i]]]) {
+                        active[kept++] = active[i];
+                    }
                 }
-                break;
+                chunk_sizes[t] = kept - first;
+            });
+            size_t kept = 0;
+            for (size_t t = 0; t < chunks_size; t++) {
+                const size_t first = active.size() * t / chunks_size;
+                std::copy_n(active.begin() + static_cast<std::ptrdiff_t>(first), chunk_sizes[t],
+                            active.begin() + static_cast<std::ptrdiff_t>(kept));
+                kept += chunk_sizes[t];
+            }
+            active.resize(kept);
         }
-        const auto end_loop_time = std::chrono::high_resolution_clock::now();
 
-        find_calls = uf.get_find_calls();
-        const std::chrono::duration<double> mst_sort_time = end_sort_time - start_sort_time;
-        sort_time = mst_sort_time.count();
-        const std::chrono::duration<double> mst_loop_time = end_loop_time - start_loop_time;
-        loop_time = mst_loop_time.count();
+        metrics.unions += mst.size();
+        scratch.union_find.parent = uf.release();
+        recorder.end(metrics.loop);
 
-        return mst;
+        recorder.begin();
+        std::sort(mst.begin(), mst.end(), lighter);
+        recorder.end(metrics.output);
     }
 
-    std::string Graph::to_str(bool with_mst, size_t points_limit, size_t connections_limit, size_t mst_limit) const {
-        if (points_limit <= 0 || points_limit > points.size()) {
-            points_limit = points.size();
+    void Graph::get_prim_MST(const MSTOptions &options, PhaseRecorder &recorder,
+                             MSTMetrics &metrics, MSTScratch &scratch) const {
+        recorder.begin();
+        std::shared_ptr<const AdjacencyIndex> cached_adjacency;
+        const AdjacencyIndex &adjacency = resolve_adjacency(options, scratch, cached_adjacency);
+        recorder.end(metrics.sort);
+
+        recorder.begin();
+        std::vector<size_t> &mst = scratch.mst;
+        std::vector<uint64_t> &keys = scratch.prim_keys;
+        std::vector<size_t> &edges = scratch.best_edges;
+        std::vector<size_t> &positions = scratch.prim_positions;
+        keys.assign(x.size(), no_key);
+        edges.assign(x.size(), no_edge);
+        positions.assign(x.size(), unseen);
+        scratch.prim_heap.reserve(x.size());
+        PointHeap heap(scratch.prim_heap, positions, keys, edges);
+
+        const size_t mst_size = x.size() > 1 ? x.size() - 1 : 0;
+        const auto relax = [&](const size_t point) {
+            const size_t first = adjacency.offsets[point], last = adjacency.offsets[point + 1];
+            for (size_t i = first; i < last; i++) {
+                const size_t target = adjacency.targets[i];
+                if (positions[target] != done &&
+                    lighter_link(adjacency.keys[i], adjacency.edges[i], keys[target], edges[target])) {
+                    keys[target] = adjacency.keys[i];
+                    edges[target] = adjacency.edges[i];
+                    heap.update(target);
+                }
+            }
+            metrics.edges_scanned += last - first;
+        };
+        for (size_t root = 0; root < x.size() && mst.size() < mst_size; root++) {
+            if (positions[root] != unseen) {
+                continue;
+            }
+            positions[root] = done;
+            relax(root);
+            while (!heap.empty() && mst.size() < mst_size) {
+                const size_t point = heap.pop();
+                mst.push_back(edges[point]);
+                relax(point);
+            }
         }
+        metrics.unions += mst.size();
+        recorder.end(metrics.loop);
 
-        std::string text = ">>> Graph <<<\n";
-        text += "Points: " + std::to_string(points.size()) + "\n";
-        text += "{\n";
-        for (size_t i = 0; i < points_limit; i++) {
-            text += "  ";
-            text += std::to_string(points[i]->index);
-            text += ": (";
-            text += std::to_string(points[i]->x);
-            text += ", ";
-            text += std::to_string(points[i]->y);
-            text += ")\n";
+        recorder.begin();
+        sort_by_weight(mst);
+        recorder.end(metrics.output);
+    }
+
+    // Array-based Prim for dense graphs: the points still outside the tree are kept in compact slot arrays, and each
+    // step scans every slot key for the cheapest link instead of maintaining a heap. O(V^2 + E) with no sort.
+    void Graph::get_dense_prim_MST(const MSTOptions &options, PhaseRecorder &recorder,
+                                   MSTMetrics &metrics, MSTScratch &scratch) const {
+        recorder.begin();
+        std::shared_ptr<const AdjacencyIndex> cached_adjacency;
+        const AdjacencyIndex &adjacency = resolve_adjacency(options, scratch, cached_adjacency);
+        recorder.end(metrics.sort);
+
+        recorder.begin();
+        std::vector<size_t> &mst = scratch.mst;
+        std::vector<uint64_t> &keys = scratch.prim_keys;
+        std::vector<size_t> &edges = scratch.best_edges;
+        std::vector<size_t> &points = scratch.components;
+        std::vector<size_t> &slots = scratch.prim_positions;
+        keys.assign(x.size(), no_key);
+        edges.assign(x.size(), no_edge);
+        points.resize(x.size());
+        slots.resize(x.size());
+        for (size_t i = 0; i < x.size(); i++) {
+            points[i] = i;
+            slots[i] = i;
         }
 
-        if (points_limit < points.size()) {
-            text += "  [...]\n";
+        const size_t mst_size = x.size() > 1 ? x.size() - 1 : 0;
+        size_t remaining = x.size();
+        while (remaining > 0 && mst.size() < mst_size) {
+            uint64_t min_key = no_key;
+            for (size_t slot = 0; slot < remaining; slot++) {
+                min_key = std::min(min_key, keys[slot]);
+            }
+            // Without any link into the tree the point in slot 0 starts the next one.
+            size_t chosen = 0;
+            if (min_key != no_key) {
+                size_t min_edge = no_edge;
+                for (size_t slot = 0; slot < remaining; slot++) {
+                    if (keys[slot] == min_key && edges[slot] < min_edge) {
+                        min_edge = edges[slot];
+                        chosen = slot;
+                    }
+                }
+                mst.push_back(min_edge);
+            }
+
+            const size_t point = points[chosen];
+            remaining--;
+            keys[chosen] = keys[remaining];
+            edges[chosen] = edges[remaining];
+            points[chosen] = points[remaining];
+            slots[points[chosen]] = chosen;
+            slots[point] = done;
+
+            const size_t first = adjacency.offsets[point], last = adjacency.offsets[point + 1];
+            for (size_t i = first; i < last; i++) {
+                const size_t slot = slots[adjacency.targets[i]];
+                if (slot != done && lighter_link(adjacency.keys[i], adjacency.edges[i], keys[slot], edges[slot])) {
+                    keys[slot] = adjacency.keys[i];
+                    edges[slot] = adjacency.edges[i];
+                }
+            }
+            metrics.edges_scanned += last - first;
         }
-        text += "}\n";
+        metrics.unions += mst.size();
+        recorder.end(metrics.loop);
+
+        recorder.begin();
+        sort_by_weight(mst);
+        recorder.end(metrics.output);
+    }
+
+    void Graph::sort_by_weight(std::vector<size_t> &edges) const {
+        std::sort(edges.begin(), edges.end(), [this](const size_t a, const size_t b) {
+            return lighter_link(weight_key(w[a]), a, weight_key(w[b]), b);
+        });
+    }
 
-        if (connections_limit <= 0 || connections_limit > edges.size()) {
-            connections_limit = edges.size();
+    MSTEngine Graph::select_engine(const MSTOptions &options) const {
+        if (options.engine != MSTEngine::Auto) {
+            return options.engine;
+        }
+        const auto points_size = static_cast<double>(x.size()), edges_size = static_cast<double>(w.size());
+        if (x.size() < 2 || w.empty()) {
+            return MSTEngine::Kruskal;
         }
 
-        text += "Edges: " + std::to_string(edges.size()) + "\n";
-        text += "{\n";
-        for (size_t i = 0; i < connections_limit; i++) {
-            text += "  ( ";
-            text += std::to_string(edges[i]->first->index);
-            text += " )->( ";
-            text += std::to_string(edges[i]->second->index);
-            text += " ) weight: ";
-            text += std::to_string(edges[i]->weight);
-            text += "\n";
+        bool has_sorted_edges = !sorted.empty(), has_adjacency = false;
+        if (options.use_cache) {
+            const std::lock_guard lock(cache->mutex);
+            has_sorted_edges = has_sorted_edges || cache->sorted_edges != nullptr;
+            has_adjacency = cache->adjacency != nullptr;
         }
 
-        if (connections_limit < edges.size()) {
-            text += "  [...]\n";
+        const EdgeCosts &edge_cost = w.size() <= cached_edges_limit ? cached_edge_costs : edge_costs;
+        const PointCosts &point_cost = x.size() <= cached_points_limit ? cached_point_costs : point_costs;
+        const double log_points = std::log2(points_size);
+        const double kruskal_loop = std::min(edges_size, points_size * log_points / std::numbers::log2e);
+        const double build = has_adjacency ? 0.0 : edges_size * edge_cost.adjacency_build;
+        const double relax = 2 * edges_size * edge_cost.relax;
+        const double kruskal = (has_sorted_edges ? 0.0 : edges_size * sort_passes(w) * edge_cost.sort_pass) +
+                               kruskal_loop * point_cost.find;
+        const double prim = build + relax * heap_relax_factor + points_size * log_points * point_cost.heap;
+        const double dense_prim = build + relax + points_size * points_size * scan_cost;
+
+        if (kruskal <= prim && kruskal <= dense_prim) {
+            return MSTEngine::Kruskal;
         }
-        text += "}\n";
+        return prim < dense_prim ? MSTEngine::Prim : MSTEngine::DensePrim;
+    }
 
-        if (with_mst) {
-            int mst1_find_calls{},
-                    mst2_find_calls{},
-                    mst3_find_calls{},
-                    mst4_find_calls{};
-            double mst_sort_time{},
-                    mst1_loop_time{},
-                    mst2_loop_time{},
-                    mst3_loop_time{},
-                    mst4_loop_time{};
-            const std::vector<Pair *> mst1 = this->get_MST(true, true,
-                                                           mst_sort_time, mst1_loop_time,
-                                                           mst1_find_calls);
-            const std::vector<Pair *> mst2 = this->get_MST(false, true,
-                                                           mst_sort_time, mst2_loop_time,
-                                                           mst2_find_calls);
-            const std::vector<Pair *> mst3 = this->get_MST(true, false,
-                                                           mst_sort_time, mst3_loop_time,
-                                                           mst3_find_calls);
-            const std::vector<Pair *> mst4 = this->get_MST(false, false,
-                                                           mst_sort_time, mst4_loop_time,
-                                                           mst4_find_calls);
-
-            if (mst_limit <= 0 || mst_limit > mst1.size()) {
-                mst_limit = mst1.size();
-            }
-
-            double weight{};
-            for (size_t i = 0; i < mst1.size(); i++) {
-                weight += mst1[i]->weight;
-            }
-
-            text += "MST: \n";
-            text += "edges: " + std::to_string(mst1.size()) + "\n";
-            text += "weight: " + std::to_string(weight) + "\n";
-            text += "sort time: " + std::to_string(mst_sort_time) + "s\n";
-            text += "kruskal time:\n";
-            text += "  path compression | rank unite: " + std::to_string(mst1_loop_time) + "s\n";
-            text += "  path compression |    ----   : " + std::to_string(mst2_loop_time) + "s\n";
-            text += "        ----       | rank unite: " + std::to_string(mst3_loop_time) + "s\n";
-            text += "        ----       |    ----   : " + std::to_string(mst4_loop_time) + "s\n";
-            text += "find calls:\n";
-            text += "  path compression | rank unite: " + std::to_string(mst1_find_calls) + "\n";
-            text += "  path compression |    ----   : " + std::to_string(mst2_find_calls) + "\n";
-            text += "        ----       | rank unite: " + std::to_string(mst3_find_calls) + "\n";
-            text += "        ----       |    ----   : " + std::to_string(mst4_find_calls) + "\n";
-
-            text += "{\n";
-            for (size_t i = 0; i < mst_limit; i++) {
-                text += "  ( ";
-                text += std::to_string(mst1[i]->first->index);
-                text += " )->( ";
-                text += std::to_string(mst1[i]->second->index);
-                text += " ) weight: ";
-                text += std::to_string(mst1[i]->weight);
-                text += "\n";
-            }
-
-            if (mst_limit < mst1.size()) {
-                text += "  [...]\n";
-            }
-            text += "}\n";
-        }
-
-        return text;
+    void Graph::get_kruskal_MST(const MSTOptions &options, PhaseRecorder &recorder,
+                                MSTMetrics &metrics, MSTScratch &scratch) const {
+        recorder.begin();
+        std::shared_ptr<const std::vector<size_t> > cached_edges;
+        std::span<const size_t> sorted_edges = sorted;
+        if (sorted.empty() && options.use_cache) {
+            cached_edges = get_cached_sorted_edges(options);
+            sorted_edges = *cached_edges;
+        } else if (sorted.empty()) {
+            radix_sort_edges(w, scratch.sort_buffer, scratch.sorted_edges,
+                             options.sort_mode == SortMode::ParallelRadix ? options.threads : 1);
+            sorted_edges = scratch.sorted_edges;
+        }
+        recorder.end(metrics.sort);
+
+        recorder.begin();
+        if (x.size() > 1) {
+            dispatch_union_find(options, x.size(), scratch.union_find, [&](auto &uf) {
+                kruskal_loop(uf, sorted_edges, u, v, x.size() - 1, scratch.mst);
+                add_counts(metrics, uf.get_counts());
+            });
+        }
+        recorder.end(metrics.loop);
+    }
+
+    const PhaseMetrics &Graph::get_load_metrics() const {
+        return load_metrics;
+    }
+
+    std::vector<size_t> Graph::get_MST(const MSTOptions &options, MSTMetrics &metrics) const {
+        MSTScratch scratch;
+        return get_MST(options, metrics, scratch);
     }
 
+    std::vector<size_t> Graph::get_MST(const MSTOptions &options, MSTMetrics &metrics, MSTScratch &scratch) const {
+        if (options.use_cache) {
+            const std::lock_guard lock(cache->mutex);
+            for (const MSTCacheEntry &entry: cache->entries) {
+                if (entry.options == options) {
+                    cache->stats.mst_hits++;
+                    metrics = entry.metrics;
+                    metrics.from_cache = true;
+                    return entry.mst;
+                }
+            }
+            cache->stats.mst_misses++;
+        }
+
+        const std::span<const size_t> solved = solve_MST(options, metrics, scratch);
+        std::vector<size_t> mst(solved.begin(), solved.end());
+        if (options.use_cache) {
+            const std::lock_guard lock(cache->mutex);
+            if (cache->entries.size() == max_cache_entries) {
+                cache->entries.erase(cache->entries.begin());
+            }
+            cache->entries.push_back({options, mst, metrics});
+        }
+        return mst;
+    }
+
+    std::span<const size_t> Graph::solve_MST(const MSTOptions &options, MSTMetrics &metrics,
+                                             MSTScratch &scratch) const {
+        metrics = {};
+        metrics.load = load_metrics;
+        PhaseRecorder recorder(options.hardware_counters);
+
+        metrics.engine = select_engine(options);
+        scratch.mst.clear();
+        scratch.mst.reserve(x.size() > 1 ? x.size() - 1 : 0);
+        switch (metrics.engine) {
+            case MSTEngine::Kruskal:
+                get_kruskal_MST(options, recorder, metrics, scratch);
+                break;
+            case MSTEngine::FilterKruskal:
+                get_filter_MST(options, recorder, metrics, scratch);
+                break;
+            case MSTEngine::LazyKruskal:
+                get_lazy_MST(options, recorder, metrics, scratch);
+                break;
+            case MSTEngine::Boruvka:
+                get_boruvka_MST(options, recorder, metrics, scratch);
+                break;
+            case MSTEngine::Prim:
+                get_prim_MST(options, recorder, metrics, scratch);
+                break;
+            case MSTEngine::DensePrim:
+                get_dense_prim_MST(options, recorder, metrics, scratch);
+                break;
+            case MSTEngine::Auto:
+                throw std::logic_error("select_engine must resolve MSTEngine::Auto");
+        }
+
+        metrics.peak_memory = peak_memory_usage();
+        metrics.scratch_memory = scratch.capacity_bytes();
+        return scratch.mst;
+    }
+
+    CacheStats Graph::get_cache_stats() const {
+        const std::lock_guard lock(cache->mutex);
+        return cache->stats;
+    }
+
+    void Graph::clear_cache() {
+        const std::lock_guard lock(cache->mutex);
+        cache->sorted_edges.reset();
+        cache->adjacency.reset();
+        cache->entries.clear();
+        cache->stats = {};
+    }
+
+    std::vector<size_t> Graph::get_MST(const MSTOptions &options) const {
+        MSTMetrics metrics;
+        return get_MST(options, metrics);
+    }
+
+    std::string engine_name(const MSTEngine engine) {
+        switch (engine) {
+            case MSTEngine::Kruskal:
+                return "kruskal";
+            case MSTEngine::FilterKruskal:
+                return "filter-kruskal";
+            case MSTEngine::LazyKruskal:
+                return "lazy-kruskal";
+            case MSTEngine::Boruvka:
+                return "boruvka";
+            case MSTEngine::Prim:
+                return "prim";
+            case MSTEngine::DensePrim:
+                return "dense-prim";
+            case MSTEngine::Auto:
+                return "auto";
+        }
+        return "unknown";
+    }
+
+    std::string Graph::to_str(const bool with_mst, const size_t points_limit, const size_t connections_limit,
+                              const size_t mst_limit) const {
+        WriteOptions options;
+        options.with_mst = with_mst;
+        options.points_limit = points_limit;
+        options.edges_limit = connections_limit;
+        options.mst_limit = mst_limit;
+        options.mst_options.count_operations = true;
+
+        std::ostringstream text;
+        {
+            GraphWriter writer(text);
+            writer.write_text(*this, options);
+        }
+        return text.str();
+    }
+
+#ifndef GRAPHLIB_WITH_PYTHON
+    void Graph::draw(const bool with_mst) const {
+        RenderOptions options;
+        options.with_mst = with_mst;
+        render_png(*this, "plots/test.png", options);
+    }
+#else
     void Graph::draw(const bool with_mst) const {
         Py_Initialize();
         PyObject *main_module = PyImport_AddModule("__main__");
         PyObject *global_dict = PyModule_GetDict(main_module);
 
-        PyObject *x_list = PyList_New(points.size());
-        PyObject *y_list = PyList_New(points.size());
-        PyObject *index_list = PyList_New(points.size());
-        for (size_t i = 0; i < points.size(); i++) {
-            PyList_SetItem(x_list, i, PyFloat_FromDouble(points[i]->x));
-            PyList_SetItem(y_list, i, PyFloat_FromDouble(points[i]->y));
-            PyList_SetItem(index_list, i, PyLong_FromUnsignedLong(points[i]->index));
+        PyObject *x_list = PyList_New(x.size());
+        PyObject *y_list = PyList_New(x.size());
+        PyObject *index_list = PyList_New(x.size());
+        for (size_t i = 0; i < x.size(); i++) {
+            PyList_SetItem(x_list, i, PyFloat_FromDouble(x[i]));
+            PyList_SetItem(y_list, i, PyFloat_FromDouble(y[i]));
+            PyList_SetItem(index_list, i, PyLong_FromUnsignedLong(i));
         }
         PyDict_SetItemString(global_dict, "x_cords", x_list);
         PyDict_SetItemString(global_dict, "y_cords", y_list);
         PyDict_SetItemString(global_dict, "indexes", index_list);
 
-        PyObject *start_x_list = PyList_New(static_cast<int>(edges.size()));
-        PyObject *start_y_list = PyList_New(static_cast<int>(edges.size()));
-        PyObject *end_x_list = PyList_New(static_cast<int>(edges.size()));
-        PyObject *end_y_list = PyList_New(static_cast<int>(edges.size()));
-        PyObject *weights_list = PyList_New(static_cast<int>(edges.size()));
-        for (size_t i = 0; i < edges.size(); i++) {
-            PyList_SetItem(start_x_list, i, PyFloat_FromDouble(edges[i]->first->x));
-            PyList_SetItem(start_y_list, i, PyFloat_FromDouble(edges[i]->first->y));
-            PyList_SetItem(end_x_list, i, PyFloat_FromDouble(edges[i]->second->x));
-            PyList_SetItem(end_y_list, i, PyFloat_FromDouble(edges[i]->second->y));
-            PyList_SetItem(weights_list, i, PyFloat_FromDouble(edges[i]->weight));
+        PyObject *start_x_list = PyList_New(static_cast<int>(w.size()));
+        PyObject *start_y_list = PyList_New(static_cast<int>(w.size()));
+        PyObject *end_x_list = PyList_New(static_cast<int>(w.size()));
+        PyObject *end_y_list = PyList_New(static_cast<int>(w.size()));
+        PyObject *weights_list = PyList_New(static_cast<int>(w.size()));
+        for (size_t i = 0; i < w.size(); i++) {
+            PyList_SetItem(start_x_list, i, PyFloat_FromDouble(x[u[i]]));
+            PyList_SetItem(start_y_list, i, PyFloat_FromDouble(y[u[i]]));
+            PyList_SetItem(end_x_list, i, PyFloat_FromDouble(x[v[i]]));
+            PyList_SetItem(end_y_list, i, PyFloat_FromDouble(y[v[i]]));
+            PyList_SetItem(weights_list, i, PyFloat_FromDouble(w[i]));
         }
         PyDict_SetItemString(global_dict, "start_x", start_x_list);
         PyDict_SetItemString(global_dict, "start_y", start_y_list);
@@ -326,7 +1435,7 @@ namespace GraphLib {
         if (with_mst) {
             int mst_find_calls{};
             double mst_sort_time{}, mst_loop_time{};
-            const std::vector<Pair *> mst = this->get_MST(true, true,
+            const std::vector<size_t> mst = this->get_MST(true, true,
                                                           mst_sort_time, mst_loop_time,
                                                           mst_find_calls);
 
@@ -335,10 +1444,10 @@ namespace GraphLib {
             mst_end_x_list = PyList_New(static_cast<int>(mst.size()));
             mst_end_y_list = PyList_New(static_cast<int>(mst.size()));
             for (size_t i = 0; i < mst.size(); i++) {
-                PyList_SetItem(mst_start_x_list, i, PyFloat_FromDouble(mst[i]->first->x));
-                PyList_SetItem(mst_start_y_list, i, PyFloat_FromDouble(mst[i]->first->y));
-                PyList_SetItem(mst_end_x_list, i, PyFloat_FromDouble(mst[i]->second->x));
-                PyList_SetItem(mst_end_y_list, i, PyFloat_FromDouble(mst[i]->second->y));
+                PyList_SetItem(mst_start_x_list, i, PyFloat_FromDouble(x[u[mst[i]]]));
+                PyList_SetItem(mst_start_y_list, i, PyFloat_FromDouble(y[u[mst[i]]]));
+                PyList_SetItem(mst_end_x_list, i, PyFloat_FromDouble(x[v[mst[i]]]));
+                PyList_SetItem(mst_end_y_list, i, PyFloat_FromDouble(y[v[mst[i]]]));
             }
             PyDict_SetItemString(global_dict, "mst_start_x", mst_start_x_list);
             PyDict_SetItemString(global_dict, "mst_start_y", mst_start_y_list);
@@ -386,4 +1495,5 @@ plt.savefig('plots/test.png')
 
         Py_Finalize();
     }
+#endif
 }
@@ -1,39 +1,234 @@
 #ifndef GRAPH_H
 #define GRAPH_H
 #include "Point.h"
+#include "Adjacency.h"
 #include "UnionFind.h"
+#include "MappedFile.h"
+#include "IncrementalMST.h"
+#include "Metrics.h"
+#include "RadixSort.h"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
 #include <string>
 #include <vector>
-#include <fstream>
 #include <chrono>
+#ifdef GRAPHLIB_WITH_PYTHON
 #include <Python.h>
+#endif
 
 namespace GraphLib {
+    struct BinaryHeader {
+        static constexpr char magic_value[8] = {'K', 'M', 'S', 'T', 'B', 'I', 'N', '1'};
+        static constexpr uint32_t byte_order_value = 0x01020304;
+        static constexpr uint64_t alignment = 64;
+        static constexpr uint32_t sorted_flag = 1;
+
+        char magic[8];
+        uint32_t byte_order;
+        uint32_t flags;
+        uint64_t points_size, edges_size;
+        uint64_t x_offset, y_offset;
+        uint64_t u_offset, v_offset, w_offset;
+        uint64_t sorted_offset;
+    };
+
+    enum class SortMode {
+        Radix,
+        ParallelRadix
+    };
+
+    enum class MSTEngine {
+        Kruskal,
+        FilterKruskal,
+        LazyKruskal,
+        Boruvka,
+        Prim,
+        DensePrim,
+        // Resolved per graph to Kruskal, Prim or DensePrim; MSTMetrics::engine records the choice.
+        Auto
+    };
+
+    std::string engine_name(MSTEngine engine);
+
+    struct MSTOptions {
+        FindPolicy find_policy = FindPolicy::Compression;
+        UnionPolicy union_policy = UnionPolicy::Rank;
+        bool count_operations = false;
+        bool hardware_counters = false;
+        MSTEngine engine = MSTEngine::Kruskal;
+        SortMode sort_mode = SortMode::Radix;
+        unsigned threads = 0;
+        // Opt-in: the cache keeps the sorted edge order (8 bytes per edge) and up to 16 trees alive until the graph
+        // changes or clear_cache() is called.
+        bool use_cache = false;
+
+        bool operator==(const MSTOptions &other) const = default;
+    };
+
+    // Every buffer an engine needs, kept between runs: once it has grown to a graph's size, solving that graph again
+    // serially makes no heap allocations.
+    struct MSTScratch {
+        std::vector<SortItem> sort_buffer;
+        std::vector<size_t> sorted_edges;
+        UnionFindStorage union_find;
+        std::vector<size_t> components, best_edges, chunk_sizes;
+        std::vector<std::vector<size_t> > selected;
+        AdjacencyIndex adjacency;
+        std::vector<uint64_t> prim_keys;
+        std::vector<size_t> prim_heap, prim_positions;
+        std::vector<size_t> mst;
+
+        size_t capacity_bytes() const;
+    };
+
+    struct CacheStats {
+        size_t sorted_hits = 0, sorted_misses = 0;
+        size_t mst_hits = 0, mst_misses = 0;
+        size_t adjacency_hits = 0, adjacency_misses = 0;
+    };
+
     class Graph {
-        std::vector<Point *> points;
-        std::vector<Pair *> edges;
+        struct Storage {
+            std::vector<double> x, y;
+            std::vector<size_t> u, v;
+            std::vector<double> w;
+        };
+
+        Storage storage;
+        std::unique_ptr<MappedFile> mapping;
+
+        std::span<const double> x, y;
+        std::span<const size_t> u, v;
+        std::span<const double> w;
+        std::span<const size_t> sorted;
+
+        std::unique_ptr<IncrementalMST> incremental;
+
+        struct MSTCacheEntry {
+            MSTOptions options;
+            std::vector<size_t> mst;
+            MSTMetrics metrics;
+        };
+
+        struct Cache {
+            std::mutex mutex;
+            std::shared_ptr<const std::vector<size_t> > sorted_edges;
+            std::shared_ptr<const AdjacencyIndex> adjacency;
+            std::vector<MSTCacheEntry> entries;
+            CacheStats stats;
+        };
+
+        std::unique_ptr<Cache> cache = std::make_unique<Cache>();
+
+        void attach_storage();
+
+        void detach_mapping();
+
+        void invalidate_cache(bool edges_changed);
+
+        std::shared_ptr<const std::vector<size_t> > get_cached_sorted_edges(const MSTOptions &options) const;
+
+        const AdjacencyIndex &resolve_adjacency(const MSTOptions &options, MSTScratch &scratch,
+                                                std::shared_ptr<const AdjacencyIndex> &cached) const;
+
+        MSTEngine select_engine(const MSTOptions &options) const;
+
+        void sort_by_weight(std::vector<size_t> &edges) const;
+
+        PhaseMetrics load_metrics;
+
+        void get_kruskal_MST(const MSTOptions &options, PhaseRecorder &recorder,
+                             MSTMetrics &metrics, MSTScratch &scratch) const;
+
+        void get_filter_MST(const MSTOptions &options, PhaseRecorder &recorder,
+                            MSTMetrics &metrics, MSTScratch &scratch) const;
+
+        void get_lazy_MST(const MSTOptions &options, PhaseRecorder &recorder,
+                          MSTMetrics &metrics, MSTScratch &scratch) const;
+
+        void get_boruvka_MST(const MSTOptions &options, PhaseRecorder &recorder,
+                             MSTMetrics &metrics, MSTScratch &scratch) const;
+
+        void get_prim_MST(const MSTOptions &options, PhaseRecorder &recorder,
+                          MSTMetrics &metrics, MSTScratch &scratch) const;
+
+        void get_dense_prim_MST(const MSTOptions &options, PhaseRecorder &recorder,
+                                MSTMetrics &metrics, MSTScratch &scratch) const;
 
     protected:
-        void load_from_file(const std::string &file_path);
+        void load_from_file(const std::string &file_path, unsigned load_threads);
+
+        void load_from_binary(std::unique_ptr<MappedFile> file, const std::string &file_path);
 
-        void add_point(double x, double y, size_t index);
+        void add_point(double x, double y);
 
-        void make_pair(Point *first, Point *second, double weight);
+        size_t make_pair(size_t first, size_t second, double weight);
 
-        std::vector<Pair *> get_sorted_edges() const;
+        std::vector<size_t> get_sorted_edges(SortMode sort_mode = SortMode::Radix, unsigned threads = 0) const;
 
     public:
-        explicit Graph(const std::string &file_path);
+        explicit Graph(const std::string &file_path, unsigned load_threads = 0);
+
+        Graph(std::vector<double> x, std::vector<double> y, std::vector<size_t> u = {}, std::vector<size_t> v = {},
+              std::vector<double> w = {});
+
+        void build_euclidean_edges(unsigned threads = 0);
+
+        void save_binary(const std::string &file_path, bool with_sorted_edges = false) const;
+
+        bool is_mapped() const;
+
+        size_t points_size() const;
+
+        size_t edges_size() const;
+
+        Point get_point(size_t index) const;
 
-        ~Graph();
+        Pair get_edge(size_t index) const;
 
-        std::vector<Pair *> get_MST(bool rank_unite, bool path_compression,
+        std::vector<Pair> to_pairs(const std::vector<size_t> &edge_indices) const;
+
+        const PhaseMetrics &get_load_metrics() const;
+
+        std::vector<size_t> get_MST(const MSTOptions &options, MSTMetrics &metrics) const;
+
+        std::vector<size_t> get_MST(const MSTOptions &options, MSTMetrics &metrics, MSTScratch &scratch) const;
+
+        // Solves into scratch.mst without consulting the MST cache. The span stays valid until scratch is reused.
+        std::span<const size_t> solve_MST(const MSTOptions &options, MSTMetrics &metrics, MSTScratch &scratch) const;
+
+        std::vector<size_t> get_MST(const MSTOptions &options = {}) const;
+
+        // Built on first use and kept until the edges change.
+        std::shared_ptr<const AdjacencyIndex> get_adjacency() const;
+
+        CacheStats get_cache_stats() const;
+
+        void clear_cache();
+
+        std::vector<size_t> get_MST(bool rank_unite, bool path_compression,
                                     double &sort_time, double &loop_time,
                                     int &find_calls) const;
 
+        void track_MST(const MSTOptions &options = {});
+
+        bool is_tracking_MST() const;
+
+        size_t add_edge(size_t first, size_t second, double weight);
+
+        void add_edges(const std::vector<Edge> &edges);
+
+        std::vector<size_t> get_tracked_MST() const;
+
+        double get_tracked_MST_weight() const;
+
+        // Small dumps only: large graphs should be streamed through GraphWriter instead of built up in memory.
         std::string to_str(bool with_mst = false, size_t points_limit = 0,
                            size_t connections_limit = 0, size_t mst_limit = 0) const;
 
+        // Writes plots/test.png through matplotlib when built with GRAPHLIB_WITH_PYTHON, natively otherwise.
         void draw(bool with_mst = false) const;
     };
 }
@@ -0,0 +1,202 @@
+#include "GraphGenerator.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+namespace GraphLib {
+    namespace {
+        constexpr size_t geometric_degree = 8;
+        constexpr double near_complete_density = 0.9;
+
+        struct EdgeArrays {
+            std::vector<double> x, y;
+            std::vector<size_t> u, v;
+            std::vector<double> w;
+
+            void reserve(const size_t points_size, const size_t edges_size) {
+                x.reserve(points_size);
+                y.reserve(points_size);
+                u.reserve(edges_size);
+                v.reserve(edges_size);
+                w.reserve(edges_size);
+            }
+
+            void add(const size_t first, const size_t second, const double weight) {
+                u.push_back(first);
+                v.push_back(second);
+                w.push_back(weight);
+            }
+        };
+
+        void random_points(EdgeArrays &graph, const size_t points_size, std::mt19937_64 &rng) {
+            std::uniform_real_distribution<double> coordinate(0.0, 1.0);
+            for (size_t i = 0; i < points_size; i++) {
+                graph.x.push_back(coordinate(rng));
+                graph.y.push_back(coordinate(rng));
+            }
+        }
+
+        // A random spanning tree followed by uniformly random extra edges.
+        void generate_random(EdgeArrays &graph, const size_t edges_size, std::mt19937_64 &rng) {
+            const size_t points_size = std::max<size_t>(2, edges_size / 4);
+            graph.reserve(points_size, edges_size);
+            random_points(graph, points_size, rng);
+
+            std::uniform_real_distribution<double> weight(0.0, 1.0);
+            for (size_t i = 1; i < points_size && graph.w.size() < edges_size; i++) {
+                graph.add(rng() % i, i, weight(rng));
+            }
+            while (graph.w.size() < edges_size) {
+                graph.add(rng() % points_size, rng() % points_size, weight(rng));
+            }
+        }
+
+        // Points are bucketed into cells of about geometric_degree points and each point is linked to its successors
+        // in cell order, weighted by distance.
+        void generate_geometric(EdgeArrays &graph, const size_t edges_size, std::mt19937_64 &rng) {
+            const size_t points_size = std::max<size_t>(2, edges_size / geometric_degree + 1);
+            graph.reserve(points_size, edges_size);
+            random_points(graph, points_size, rng);
+
+            const auto side = static_cast<size_t>(std::max(1.0, std::sqrt(static_cast<double>(points_size) /
+                                                                          geometric_degree)));
+            const auto cell = [&](const size_t i) {
+                const size_t cx = std::min(side - 1, static_cast<size_t>(graph.x[i] * static_cast<double>(side)));
+                const size_t cy = std::min(side - 1, static_cast<size_t>(graph.y[i] * static_cast<double>(side)));
+                return cy * side + (cy % 2 == 0 ? cx : side - 1 - cx);
+            };
+            std::vector<std::pair<size_t, size_t> > order(points_size);
+            for (size_t i = 0; i < points_size; i++) {
+                order[i] = {cell(i), i};
+            }
+            std::sort(order.begin(), order.end());
+
+            for (size_t k = 1; k <= geometric_degree && graph.w.size() < edges_size; k++) {
+                for (size_t i = 0; i + k < points_size && graph.w.size() < edges_size; i++) {
+                    const size_t first = order[i].second, second = order[i + k].second;
+                    graph.add(first, second, std::hypot(graph.x[first] - graph.x[second],
+                                                        graph.y[first] - graph.y[second]));
+                }
+            }
+        }
+
+        // A lattice of about sqrt(E / 2) columns with small integer weights, so most weights are tied. Edges left over
+        // after the last full row are parallel copies of random row edges.
+        void generate_grid(EdgeArrays &graph, const size_t edges_size, std::mt19937_64 &rng) {
+            const size_t columns = std::max<size_t>(2, static_cast<size_t>(
+                                                           std::ceil(std::sqrt(static_cast<double>(edges_size) / 2.0))));
+            const size_t rows = std::max<size_t>(1, (edges_size + columns) / (2 * columns - 1));
+            graph.reserve(rows * columns, edges_size);
+            for (size_t row = 0; row < rows; row++) {
+                for (size_t column = 0; column < columns; column++) {
+                    graph.x.push_back(static_cast<double>(column));
+                    graph.y.push_back(static_cast<double>(row));
+                }
+            }
+
+            std::uniform_int_distribution<int> weight(1, 16);
+            for (size_t row = 0; row < rows && graph.w.size() < edges_size; row++) {
+                for (size_t column = 0; column < columns && graph.w.size() < edges_size; column++) {
+                    const size_t point = row * columns + column;
+                    if (row > 0) {
+                        graph.add(point - columns, point, weight(rng));
+                    }
+                    if (column > 0 && graph.w.size() < edges_size) {
+                        graph.add(point - 1, point, weight(rng));
+                    }
+                }
+            }
+            while (graph.w.size() < edges_size) {
+                const size_t point = (rng() % rows) * columns + rng() % (columns - 1);
+                graph.add(point, point + 1, weight(rng));
+            }
+        }
+
+        // Every pair of points is kept with probability near_complete_density.
+        void generate_near_complete(EdgeArrays &graph, const size_t edges_size, std::mt19937_64 &rng) {
+            const double pairs = static_cast<double>(edges_size) / near_complete_density;
+            const auto points_size = std::max<size_t>(2, static_cast<size_t>(
+                                                             std::ceil((1.0 + std::sqrt(1.0 + 8.0 * pairs)) / 2.0)));
+            graph.reserve(points_size, edges_size);
+            random_points(graph, points_size, rng);
+
+            std::uniform_real_distribution<double> weight(0.0, 1.0);
+            std::bernoulli_distribution keep(near_complete_density);
+            for (size_t first = 0; first < points_size && graph.w.size() < edges_size; first++) {
+                for (size_t second = first + 1; second < points_size && graph.w.size() < edges_size; second++) {
+                    if (keep(rng)) {
+                        graph.add(first, second, weight(rng));
+                    }
+                }
+            }
+        }
+
+        // A path whose weights grow along it, plus chords that are only just heavier than the path edge they close.
+        // Kruskal has to scan almost every edge before the tree is complete, and unions without a rank policy build
+        // long parent chains.
+        void generate_chain(EdgeArrays &graph, const size_t edges_size, std::mt19937_64 &rng) {
+            const size_t points_size = std::max<size_t>(3, edges_size / 2 + 1);
+            graph.reserve(points_size, edges_size);
+            random_points(graph, points_size, rng);
+
+            for (size_t i = 0; i + 1 < points_size && graph.w.size() < edges_size; i++) {
+                graph.add(i, i + 1, static_cast<double>(i));
+            }
+            while (graph.w.size() < edges_size) {
+                const size_t second = 2 + rng() % (points_size - 2);
+                const size_t first = rng() % (second - 1);
+                graph.add(first, second, static_cast<double>(second - 1) + 0.5);
+            }
+        }
+    }
+
+    std::string graph_kind_name(const GraphKind kind) {
+        switch (kind) {
+            case GraphKind::Random:
+                return "random";
+            case GraphKind::Geometric:
+                return "geometric";
+            case GraphKind::Grid:
+                return "grid";
+            case GraphKind::NearComplete:
+                return "near-complete";
+            case GraphKind::Chain:
+                return "chain";
+        }
+        return "unknown";
+    }
+
+    GraphKind parse_graph_kind(const std::string &name) {
+        for (const GraphKind kind: {GraphKind::Random, GraphKind::Geometric, GraphKind::Grid, GraphKind::NearComplete,
+                                    GraphKind::Chain}) {
+            if (graph_kind_name(kind) == name) {
+                return kind;
+            }
+        }
+        throw std::runtime_error("Unknown graph kind: " + name);
+    }
+
+    Graph generate_graph(const GraphKind kind, const size_t edges_size, const uint64_t seed) {
+        std::mt19937_64 rng(seed);
+        EdgeArrays graph;
+        switch (kind) {
+            case GraphKind::Random:
+                generate_random(graph, edges_size, rng);
+                break;
+            case GraphKind::Geometric:
+                generate_geometric(graph, edges_size, rng);
+                break;
+            case GraphKind::Grid:
+                generate_grid(graph, edges_size, rng);
+                break;
+            case GraphKind::NearComplete:
+                generate_near_complete(graph, edges_size, rng);
+                break;
+            case GraphKind::Chain:
+                generate_chain(graph, edges_size, rng);
+                break;
+        }
+        return {std::move(graph.x), std::move(graph.y), std::move(graph.u), std::move(graph.v), std::move(graph.w)};
+    }
+}
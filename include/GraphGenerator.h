@@ -0,0 +1,23 @@
+#ifndef GRAPHGENERATOR_H
+#define GRAPHGENERATOR_H
+#include "Graph.h"
+#include <cstdint>
+#include <string>
+
+namespace GraphLib {
+    enum class GraphKind {
+        Random,
+        Geometric,
+        Grid,
+        NearComplete,
+        Chain
+    };
+
+    std::string graph_kind_name(GraphKind kind);
+
+    GraphKind parse_graph_kind(const std::string &name);
+
+    Graph generate_graph(GraphKind kind, size_t edges_size, uint64_t seed = 42);
+}
+
+#endif
@@ -0,0 +1,258 @@
+#include "GraphWriter.h"
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace GraphLib {
+    namespace {
+        constexpr size_t flush_threshold = 1 << 20;
+    }
+
+    GraphWriter::GraphWriter(std::ostream &stream) : stream(&stream) {
+        buffer.reserve(flush_threshold + 64);
+    }
+
+    GraphWriter::GraphWriter(const int fd) : fd(fd) {
+        buffer.reserve(flush_threshold + 64);
+    }
+
+    GraphWriter::~GraphWriter() {
+        try {
+            flush();
+        } catch (const std::exception &) {
+        }
+    }
+
+    void GraphWriter::append(const std::string_view text) {
+        buffer.append(text);
+        if (buffer.size() >= flush_threshold) {
+            flush();
+        }
+    }
+
+    void GraphWriter::append(const uint64_t value) {
+        char digits[24];
+        const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        append(std::string_view(digits, result.ptr - digits));
+    }
+
+    // Six decimals, the same text std::to_string prints.
+    void GraphWriter::append_fixed(const double value) {
+        char digits[352];
+        const auto result = std::to_chars(digits, digits + sizeof(digits), value, std::chars_format::fixed, 6);
+        append(std::string_view(digits, result.ptr - digits));
+    }
+
+    // Shortest text that reads back to the same double.
+    void GraphWriter::append_exact(const double value) {
+        char digits[32];
+        const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        append(std::string_view(digits, result.ptr - digits));
+    }
+
+    void GraphWriter::append_bytes(const void *data, const size_t size) {
+        append(std::string_view(static_cast<const char *>(data), size));
+    }
+
+    void GraphWriter::append_edge_text(const Graph &graph, const size_t edge) {
+        const Pair pair = graph.get_edge(edge);
+        append("  ( ");
+        append(pair.first.index);
+        append(" )->( ");
+        append(pair.second.index);
+        append(" ) weight: ");
+        append_fixed(pair.weight);
+        append("\n");
+    }
+
+    void GraphWriter::write_graph(const Graph &graph) {
+        const size_t points_size = graph.points_size(), edges_size = graph.edges_size();
+        append(points_size);
+        append("\n");
+        for (size_t i = 0; i < points_size; i++) {
+            const Point point = graph.get_point(i);
+            append_exact(point.x);
+            append(" ");
+            append_exact(point.y);
+            append("\n");
+        }
+        append(edges_size);
+        append("\n");
+        for (size_t i = 0; i < edges_size; i++) {
+            const Pair pair = graph.get_edge(i);
+            append(pair.first.index);
+            append(" ");
+            append(pair.second.index);
+            append(" ");
+            append_exact(pair.weight);
+            append("\n");
+        }
+    }
+
+    void GraphWriter::write_text(const Graph &graph, const WriteOptions &options) {
+        const size_t points_size = graph.points_size(), edges_size = graph.edges_size();
+        const size_t points_limit = options.points_limit == 0
+                                        ? points_size
+                                        : std::min(options.points_limit, points_size);
+        const size_t edges_limit = options.edges_limit == 0 ? edges_size : std::min(options.edges_limit, edges_size);
+
+        append(">>> Graph <<<\nPoints: ");
+        append(points_size);
+        append("\n{\n");
+        for (size_t i = 0; i < points_limit; i++) {
+            const Point point = graph.get_point(i);
+            append("  ");
+            append(i);
+            append(": (");
+            append_fixed(point.x);
+            append(", ");
+            append_fixed(point.y);
+            append(")\n");
+        }
+        if (points_limit < points_size) {
+            append("  [...]\n");
+        }
+        append("}\n");
+
+        append("Edges: ");
+        append(edges_size);
+        append("\n{\n");
+        for (size_t i = 0; i < edges_limit; i++) {
+            append_edge_text(graph, i);
+        }
+        if (edges_limit < edges_size) {
+            append("  [...]\n");
+        }
+        append("}\n");
+
+        if (!options.with_mst) {
+            return;
+        }
+
+        MSTMetrics metrics;
+        const std::vector<size_t> mst = graph.get_MST(options.mst_options, metrics);
+        const size_t mst_limit = options.mst_limit == 0 ? mst.size() : std::min(options.mst_limit, mst.size());
+        double weight{};
+        for (const size_t edge: mst) {
+            weight += graph.get_edge(edge).weight;
+        }
+
+        append("MST: \nedges: ");
+        append(mst.size());
+        append("\nweight: ");
+        append_fixed(weight);
+        append("\nsort time: ");
+        append_fixed(metrics.sort.time);
+        append("s\nkruskal time: ");
+        append_fixed(metrics.loop.time);
+        append("s\nfind calls: ");
+        append(metrics.finds + metrics.compression_hops);
+        append("\n{\n");
+        for (size_t i = 0; i < mst_limit; i++) {
+            append_edge_text(graph, mst[i]);
+        }
+        if (mst_limit < mst.size()) {
+            append("  [...]\n");
+        }
+        append("}\n");
+    }
+
+    void GraphWriter::write_csv(const Graph &graph, const WriteOptions &options) {
+        const size_t edges_size = graph.edges_size();
+        const size_t edges_limit = options.edges_limit == 0 ? edges_size : std::min(options.edges_limit, edges_size);
+
+        std::vector<bool> in_mst;
+        if (options.with_mst) {
+            in_mst.assign(edges_size, false);
+            for (const size_t edge: graph.get_MST(options.mst_options)) {
+                in_mst[edge] = true;
+            }
+        }
+
+        append(options.with_mst ? "first,second,weight,mst\n" : "first,second,weight\n");
+        for (size_t i = 0; i < edges_limit; i++) {
+            const Pair pair = graph.get_edge(i);
+            append(pair.first.index);
+            append(",");
+            append(pair.second.index);
+            append(",");
+            append_exact(pair.weight);
+            if (options.with_mst) {
+                append(in_mst[i] ? ",1" : ",0");
+            }
+            append("\n");
+        }
+    }
+
+    void GraphWriter::write_MST(const Graph &graph, const std::span<const size_t> mst, const MSTFormat format) {
+        switch (format) {
+            case MSTFormat::Text:
+                for (const size_t edge: mst) {
+                    append_edge_text(graph, edge);
+                }
+                break;
+            case MSTFormat::CSV:
+                append("first,second,weight\n");
+                for (const size_t edge: mst) {
+                    const Pair pair = graph.get_edge(edge);
+                    append(pair.first.index);
+                    append(",");
+                    append(pair.second.index);
+                    append(",");
+                    append_exact(pair.weight);
+                    append("\n");
+                }
+                break;
+            case MSTFormat::Binary: {
+                MSTBinaryHeader header{};
+                std::memcpy(header.magic, MSTBinaryHeader::magic_value, sizeof(header.magic));
+                header.byte_order = MSTBinaryHeader::byte_order_value;
+                header.points_size = graph.points_size();
+                header.edges_size = mst.size();
+                append_bytes(&header, sizeof(header));
+                for (const size_t edge: mst) {
+                    const Pair pair = graph.get_edge(edge);
+                    const uint64_t first = pair.first.index, second = pair.second.index;
+                    append_bytes(&first, sizeof(first));
+                    append_bytes(&second, sizeof(second));
+                    append_bytes(&pair.weight, sizeof(pair.weight));
+                }
+                break;
+            }
+        }
+    }
+
+    void GraphWriter::flush() {
+        if (buffer.empty()) {
+            return;
+        }
+        if (stream) {
+            stream->write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            if (!*stream) {
+                throw std::runtime_error("Unable to write graph output to stream");
+            }
+        } else {
+            size_t written = 0;
+            while (written < buffer.size()) {
+                const ssize_t result = ::write(fd, buffer.data() + written, buffer.size() - written);
+                if (result < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (result <= 0) {
+                    throw std::runtime_error("Unable to write graph output to file descriptor " +
+                                             std::to_string(fd) + ": " + std::strerror(errno));
+                }
+                written += static_cast<size_t>(result);
+            }
+        }
+        bytes_written += buffer.size();
+        buffer.clear();
+    }
+
+    size_t GraphWriter::get_bytes_written() const {
+        return bytes_written;
+    }
+}
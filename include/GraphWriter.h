@@ -0,0 +1,84 @@
+#ifndef GRAPHWRITER_H
+#define GRAPHWRITER_H
+#include "Graph.h"
+#include <cstdint>
+#include <ostream>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace GraphLib {
+    enum class MSTFormat {
+        Text,
+        CSV,
+        Binary
+    };
+
+    // Limits of 0 write everything, as in Graph::to_str.
+    struct WriteOptions {
+        bool with_mst = false;
+        size_t points_limit = 0;
+        size_t edges_limit = 0;
+        size_t mst_limit = 0;
+        MSTOptions mst_options;
+    };
+
+    // Binary MST edge lists start with this header, followed by edges_size records of (uint64 first, uint64 second,
+    // double weight) in native byte order.
+    struct MSTBinaryHeader {
+        static constexpr char magic_value[8] = {'K', 'M', 'S', 'T', 'E', 'D', 'G', '1'};
+        static constexpr uint32_t byte_order_value = 0x01020304;
+
+        char magic[8];
+        uint32_t byte_order;
+        uint32_t reserved;
+        uint64_t points_size, edges_size;
+    };
+
+    // Formats numbers with std::to_chars into one reusable buffer that is flushed to the stream or file descriptor in
+    // large blocks. A file descriptor is not closed by the writer.
+    class GraphWriter {
+        std::ostream *stream = nullptr;
+        int fd = -1;
+        std::string buffer;
+        size_t bytes_written = 0;
+
+        void append(std::string_view text);
+
+        void append(uint64_t value);
+
+        void append_fixed(double value);
+
+        void append_exact(double value);
+
+        void append_bytes(const void *data, size_t size);
+
+        void append_edge_text(const Graph &graph, size_t edge);
+
+    public:
+        explicit GraphWriter(std::ostream &stream);
+
+        explicit GraphWriter(int fd);
+
+        GraphWriter(const GraphWriter &) = delete;
+
+        GraphWriter &operator=(const GraphWriter &) = delete;
+
+        ~GraphWriter();
+
+        // The text input format Graph loads: point count, points, edge count, edges.
+        void write_graph(const Graph &graph);
+
+        void write_text(const Graph &graph, const WriteOptions &options = {});
+
+        void write_csv(const Graph &graph, const WriteOptions &options = {});
+
+        void write_MST(const Graph &graph, std::span<const size_t> mst, MSTFormat format);
+
+        void flush();
+
+        size_t get_bytes_written() const;
+    };
+}
+
+#endif
@@ -0,0 +1,81 @@
+#include "IncrementalMST.h"
+
+namespace GraphLib {
+    IncrementalMST::IncrementalMST(const size_t points_size, const std::span<const size_t> u,
+                                   const std::span<const size_t> v, const std::span<const double> w,
+                                   const std::vector<size_t> &mst) : tree(points_size), weight(0.0) {
+        point_nodes.resize(points_size);
+        for (size_t i = 0; i < points_size; i++) {
+            point_nodes[i] = i;
+        }
+        for (const size_t edge: mst) {
+            insert(edge, u[edge], v[edge], weight_key(w[edge]), w[edge]);
+        }
+    }
+
+    void IncrementalMST::insert(const size_t edge, const size_t first, const size_t second, const uint64_t key,
+                                const double edge_weight) {
+        const size_t node = tree.add_weighted_node({key, edge});
+        if (endpoints.size() <= node) {
+            endpoints.resize(node + 1);
+        }
+        endpoints[node] = {point_nodes[first], point_nodes[second]};
+        tree.link(node, point_nodes[first]);
+        tree.link(node, point_nodes[second]);
+        edges.insert({key, edge});
+        weight += edge_weight;
+    }
+
+    void IncrementalMST::erase(const size_t node) {
+        const SortItem value = tree.get_value(node);
+        tree.cut(node, endpoints[node].first);
+        tree.cut(node, endpoints[node].second);
+        tree.remove_node(node);
+        edges.erase({value.key, value.index});
+        weight -= key_weight(value.key);
+    }
+
+    void IncrementalMST::add_point() {
+        point_nodes.push_back(tree.add_node());
+    }
+
+    size_t IncrementalMST::add_edge(const size_t edge, const size_t first, const size_t second,
+                                    const double edge_weight) {
+        if (first == second) {
+            return edge;
+        }
+
+        const uint64_t key = weight_key(edge_weight);
+        if (!tree.connected(point_nodes[first], point_nodes[second])) {
+            insert(edge, first, second, key, edge_weight);
+            return no_edge;
+        }
+
+        const size_t heaviest = tree.path_max(point_nodes[first], point_nodes[second]);
+        const SortItem value = tree.get_value(heaviest);
+        if (value.key < key || (value.key == key && value.index < edge)) {
+            return edge;
+        }
+
+        erase(heaviest);
+        insert(edge, first, second, key, edge_weight);
+        return value.index;
+    }
+
+    size_t IncrementalMST::size() const {
+        return edges.size();
+    }
+
+    double IncrementalMST::get_weight() const {
+        return weight;
+    }
+
+    std::vector<size_t> IncrementalMST::get_edges() const {
+        std::vector<size_t> mst;
+        mst.reserve(edges.size());
+        for (const auto &edge: edges) {
+            mst.push_back(edge.second);
+        }
+        return mst;
+    }
+}
@@ -0,0 +1,38 @@
+#ifndef INCREMENTALMST_H
+#define INCREMENTALMST_H
+#include "LinkCutTree.h"
+#include <set>
+#include <span>
+#include <vector>
+
+namespace GraphLib {
+    class IncrementalMST {
+        LinkCutTree tree;
+        std::set<std::pair<uint64_t, size_t> > edges;
+        std::vector<size_t> point_nodes;
+        std::vector<std::pair<size_t, size_t> > endpoints;
+        double weight;
+
+        void insert(size_t edge, size_t first, size_t second, uint64_t key, double edge_weight);
+
+        void erase(size_t node);
+
+    public:
+        static constexpr size_t no_edge = static_cast<size_t>(-1);
+
+        IncrementalMST(size_t points_size, std::span<const size_t> u, std::span<const size_t> v,
+                       std::span<const double> w, const std::vector<size_t> &mst);
+
+        void add_point();
+
+        size_t add_edge(size_t edge, size_t first, size_t second, double edge_weight);
+
+        size_t size() const;
+
+        double get_weight() const;
+
+        std::vector<size_t> get_edges() const;
+    };
+}
+
+#endif
@@ -0,0 +1,140 @@
+#include "KdTree.h"
+#include <algorithm>
+#include <limits>
+
+namespace GraphLib {
+    namespace {
+        constexpr size_t leaf_size = 32;
+        constexpr size_t mixed = static_cast<size_t>(-1);
+    }
+
+    KdTree::KdTree(const std::span<const double> x, const std::span<const double> y) : order(x.size()) {
+        for (size_t i = 0; i < order.size(); i++) {
+            order[i] = i;
+        }
+        nodes.reserve(2 * (order.size() / leaf_size + 1));
+        if (!order.empty()) {
+            build(x, y, 0, order.size());
+        }
+
+        this->x.resize(order.size());
+        this->y.resize(order.size());
+        for (size_t i = 0; i < order.size(); i++) {
+            this->x[i] = x[order[i]];
+            this->y[i] = y[order[i]];
+        }
+        component.assign(order.size(), mixed);
+        node_component.assign(nodes.size(), mixed);
+    }
+
+    size_t KdTree::build(const std::span<const double> point_x, const std::span<const double> point_y,
+                         const size_t begin, const size_t end) {
+        Node node{
+            std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(),
+            std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(),
+            begin, end, 0, 0
+        };
+        for (size_t i = begin; i < end; i++) {
+            node.min_x = std::min(node.min_x, point_x[order[i]]);
+            node.max_x = std::max(node.max_x, point_x[order[i]]);
+            node.min_y = std::min(node.min_y, point_y[order[i]]);
+            node.max_y = std::max(node.max_y, point_y[order[i]]);
+        }
+
+        const size_t index = nodes.size();
+        nodes.push_back(node);
+        if (end - begin <= leaf_size) {
+            return index;
+        }
+
+        const bool split_x = node.max_x - node.min_x >= node.max_y - node.min_y;
+        const size_t middle = begin + (end - begin) / 2;
+        std::nth_element(order.begin() + static_cast<std::ptrdiff_t>(begin),
+                         order.begin() + static_cast<std::ptrdiff_t>(middle),
+                         order.begin() + static_cast<std::ptrdiff_t>(end),
+                         [&point_x, &point_y, split_x](const size_t a, const size_t b) {
+                             return split_x ? point_x[a] < point_x[b] : point_y[a] < point_y[b];
+                         });
+
+        const size_t left = build(point_x, point_y, begin, middle);
+        const size_t right = build(point_x, point_y, middle, end);
+        nodes[index].left = left;
+        nodes[index].right = right;
+        return index;
+    }
+
+    std::span<const size_t> KdTree::get_order() const {
+        return order;
+    }
+
+    void KdTree::set_components(const std::span<const size_t> components) {
+        for (size_t i = 0; i < order.size(); i++) {
+            component[i] = components[order[i]];
+        }
+        for (size_t i = nodes.size(); i-- > 0;) {
+            const Node &node = nodes[i];
+            if (node.left == 0) {
+                size_t uniform = component[node.begin];
+                for (size_t j = node.begin + 1; j < node.end && uniform != mixed; j++) {
+                    if (component[j] != uniform) {
+                        uniform = mixed;
+                    }
+                }
+                node_component[i] = uniform;
+            } else {
+                node_component[i] = node_component[node.left] == node_component[node.right]
+                                        ? node_component[node.left]
+                                        : mixed;
+            }
+        }
+    }
+
+    double KdTree::box_distance(const Node &node, const double query_x, const double query_y) const {
+        const double dx = std::max(std::max(node.min_x - query_x, query_x - node.max_x), 0.0);
+        const double dy = std::max(std::max(node.min_y - query_y, query_y - node.max_y), 0.0);
+        return dx * dx + dy * dy;
+    }
+
+    void KdTree::nearest(const size_t node_index, const double node_distance, const double query_x,
+                         const double query_y, const size_t query_component,
+                         double &best_distance, size_t &best) const {
+        if (node_distance > best_distance || node_component[node_index] == query_component) {
+            return;
+        }
+
+        const Node &node = nodes[node_index];
+        if (node.left == 0) {
+            for (size_t i = node.begin; i < node.end; i++) {
+                if (component[i] == query_component) {
+                    continue;
+                }
+                const double dx = x[i] - query_x, dy = y[i] - query_y;
+                const double distance = dx * dx + dy * dy;
+                if (distance < best_distance || (distance == best_distance && order[i] < best)) {
+                    best_distance = distance;
+                    best = order[i];
+                }
+            }
+            return;
+        }
+
+        const double left_distance = box_distance(nodes[node.left], query_x, query_y);
+        const double right_distance = box_distance(nodes[node.right], query_x, query_y);
+        if (left_distance <= right_distance) {
+            nearest(node.left, left_distance, query_x, query_y, query_component, best_distance, best);
+            nearest(node.right, right_distance, query_x, query_y, query_component, best_distance, best);
+        } else {
+            nearest(node.right, right_distance, query_x, query_y, query_component, best_distance, best);
+            nearest(node.left, left_distance, query_x, query_y, query_component, best_distance, best);
+        }
+    }
+
+    size_t KdTree::nearest_foreign(const double query_x, const double query_y, const size_t query_component,
+                                   double &distance) const {
+        size_t best = no_point;
+        if (!nodes.empty()) {
+            nearest(0, box_distance(nodes[0], query_x, query_y), query_x, query_y, query_component, distance, best);
+        }
+        return best;
+    }
+}
@@ -0,0 +1,40 @@
+#ifndef KDTREE_H
+#define KDTREE_H
+#include <span>
+#include <vector>
+
+namespace GraphLib {
+    class KdTree {
+        struct Node {
+            double min_x, max_x, min_y, max_y;
+            size_t begin, end;
+            size_t left, right;
+        };
+
+        std::vector<size_t> order;
+        std::vector<double> x, y;
+        std::vector<size_t> component;
+        std::vector<Node> nodes;
+        std::vector<size_t> node_component;
+
+        size_t build(std::span<const double> point_x, std::span<const double> point_y, size_t begin, size_t end);
+
+        double box_distance(const Node &node, double query_x, double query_y) const;
+
+        void nearest(size_t node, double node_distance, double query_x, double query_y, size_t query_component,
+                     double &best_distance, size_t &best) const;
+
+    public:
+        static constexpr size_t no_point = static_cast<size_t>(-1);
+
+        KdTree(std::span<const double> x, std::span<const double> y);
+
+        std::span<const size_t> get_order() const;
+
+        void set_components(std::span<const size_t> components);
+
+        size_t nearest_foreign(double query_x, double query_y, size_t query_component, double &distance) const;
+    };
+}
+
+#endif
@@ -0,0 +1,172 @@
+#include "LinkCutTree.h"
+#include <utility>
+
+namespace GraphLib {
+    namespace {
+        bool value_less(const SortItem &a, const SortItem &b) {
+            return a.key < b.key || (a.key == b.key && a.index < b.index);
+        }
+    }
+
+    LinkCutTree::LinkCutTree(const size_t n) {
+        nodes.reserve(2 * n);
+        for (size_t i = 0; i < n; i++) {
+            add_node();
+        }
+    }
+
+    size_t LinkCutTree::add_node() {
+        const Node node{{no_node, no_node}, no_node, false, false, {0, 0}, no_node};
+        if (!free_nodes.empty()) {
+            const size_t index = free_nodes.back();
+            free_nodes.pop_back();
+            nodes[index] = node;
+            return index;
+        }
+        nodes.push_back(node);
+        return nodes.size() - 1;
+    }
+
+    size_t LinkCutTree::add_weighted_node(const SortItem &value) {
+        const size_t index = add_node();
+        nodes[index].weighted = true;
+        nodes[index].value = value;
+        nodes[index].max_node = index;
+        return index;
+    }
+
+    void LinkCutTree::remove_node(const size_t node) {
+        free_nodes.push_back(node);
+    }
+
+    const SortItem &LinkCutTree::get_value(const size_t node) const {
+        return nodes[node].value;
+    }
+
+    bool LinkCutTree::is_root(const size_t node) const {
+        const size_t parent = nodes[node].parent;
+        return parent == no_node || (nodes[parent].child[0] != node && nodes[parent].child[1] != node);
+    }
+
+    void LinkCutTree::push(const size_t node) {
+        Node &current = nodes[node];
+        if (!current.reversed) {
+            return;
+        }
+        std::swap(current.child[0], current.child[1]);
+        for (const size_t child: current.child) {
+            if (child != no_node) {
+                nodes[child].reversed = !nodes[child].reversed;
+            }
+        }
+        current.reversed = false;
+    }
+
+    void LinkCutTree::update(const size_t node) {
+        Node &current = nodes[node];
+        current.max_node = current.weighted ? node : no_node;
+        for (const size_t child: current.child) {
+            if (child == no_node || nodes[child].max_node == no_node) {
+                continue;
+            }
+            const size_t candidate = nodes[child].max_node;
+            if (current.max_node == no_node || value_less(nodes[current.max_node].value, nodes[candidate].value)) {
+                current.max_node = candidate;
+            }
+        }
+    }
+
+    void LinkCutTree::rotate(const size_t node) {
+        const size_t parent = nodes[node].parent;
+        const size_t grand = nodes[parent].parent;
+        const int side = nodes[parent].child[1] == node;
+        const size_t moved = nodes[node].child[side ^ 1];
+
+        if (!is_root(parent)) {
+            nodes[grand].child[nodes[grand].child[1] == parent] = node;
+        }
+        nodes[node].parent = grand;
+
+        nodes[parent].child[side] = moved;
+        if (moved != no_node) {
+            nodes[moved].parent = parent;
+        }
+
+        nodes[node].child[side ^ 1] = parent;
+        nodes[parent].parent = node;
+
+        update(parent);
+        update(node);
+    }
+
+    void LinkCutTree::splay(const size_t node) {
+        path.assign(1, node);
+        for (size_t current = node; !is_root(current); current = nodes[current].parent) {
+            path.push_back(nodes[current].parent);
+        }
+        for (size_t i = path.size(); i-- > 0;) {
+            push(path[i]);
+        }
+
+        while (!is_root(node)) {
+            const size_t parent = nodes[node].parent;
+            if (!is_root(parent)) {
+                const size_t grand = nodes[parent].parent;
+                const bool zig_zig = (nodes[grand].child[1] == parent) == (nodes[parent].child[1] == node);
+                rotate(zig_zig ? parent : node);
+            }
+            rotate(node);
+        }
+    }
+
+    void LinkCutTree::access(const size_t node) {
+        size_t last = no_node;
+        for (size_t current = node; current != no_node; current = nodes[current].parent) {
+            splay(current);
+            nodes[current].child[1] = last;
+            update(current);
+            last = current;
+        }
+        splay(node);
+    }
+
+    void LinkCutTree::make_root(const size_t node) {
+        access(node);
+        nodes[node].reversed = !nodes[node].reversed;
+        push(node);
+    }
+
+    size_t LinkCutTree::find_root(size_t node) {
+        access(node);
+        push(node);
+        while (nodes[node].child[0] != no_node) {
+            node = nodes[node].child[0];
+            push(node);
+        }
+        splay(node);
+        return node;
+    }
+
+    bool LinkCutTree::connected(const size_t node_x, const size_t node_y) {
+        return node_x == node_y || find_root(node_x) == find_root(node_y);
+    }
+
+    void LinkCutTree::link(const size_t node_x, const size_t node_y) {
+        make_root(node_x);
+        nodes[node_x].parent = node_y;
+    }
+
+    void LinkCutTree::cut(const size_t node_x, const size_t node_y) {
+        make_root(node_x);
+        access(node_y);
+        nodes[node_y].child[0] = no_node;
+        nodes[node_x].parent = no_node;
+        update(node_y);
+    }
+
+    size_t LinkCutTree::path_max(const size_t node_x, const size_t node_y) {
+        make_root(node_x);
+        access(node_y);
+        return nodes[node_y].max_node;
+    }
+}
@@ -0,0 +1,60 @@
+#ifndef LINKCUTTREE_H
+#define LINKCUTTREE_H
+#include "RadixSort.h"
+#include <vector>
+
+namespace GraphLib {
+    class LinkCutTree {
+        struct Node {
+            size_t child[2];
+            size_t parent;
+            bool reversed;
+            bool weighted;
+            SortItem value;
+            size_t max_node;
+        };
+
+        std::vector<Node> nodes;
+        std::vector<size_t> free_nodes;
+        std::vector<size_t> path;
+
+        bool is_root(size_t node) const;
+
+        void push(size_t node);
+
+        void update(size_t node);
+
+        void rotate(size_t node);
+
+        void splay(size_t node);
+
+        void access(size_t node);
+
+        void make_root(size_t node);
+
+        size_t find_root(size_t node);
+
+    public:
+        static constexpr size_t no_node = static_cast<size_t>(-1);
+
+        explicit LinkCutTree(size_t n = 0);
+
+        size_t add_node();
+
+        size_t add_weighted_node(const SortItem &value);
+
+        void remove_node(size_t node);
+
+        const SortItem &get_value(size_t node) const;
+
+        bool connected(size_t node_x, size_t node_y);
+
+        void link(size_t node_x, size_t node_y);
+
+        void cut(size_t node_x, size_t node_y);
+
+        size_t path_max(size_t node_x, size_t node_y);
+    };
+}
+
+#endif
@@ -0,0 +1,52 @@
+#include "MappedFile.h"
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace GraphLib {
+    MappedFile::MappedFile(const std::string &file_path) : data(nullptr), length(0) {
+        const int fd = open(file_path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Unable to open file from: " + file_path);
+        }
+
+        struct stat info{};
+        if (fstat(fd, &info) != 0) {
+            close(fd);
+            throw std::runtime_error("Unable to stat file: " + file_path);
+        }
+
+        length = static_cast<size_t>(info.st_size);
+        if (length > 0) {
+            void *mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping == MAP_FAILED) {
+                close(fd);
+                throw std::runtime_error("Unable to map file: " + file_path);
+            }
+            madvise(mapping, length, MADV_SEQUENTIAL);
+            data = static_cast<const char *>(mapping);
+        }
+
+        close(fd);
+    }
+
+    MappedFile::~MappedFile() {
+        if (data != nullptr) {
+            munmap(const_cast<char *>(data), length);
+        }
+    }
+
+    const char *MappedFile::begin() const {
+        return data;
+    }
+
+    const char *MappedFile::end() const {
+        return data + length;
+    }
+
+    size_t MappedFile::size() const {
+        return length;
+    }
+}
@@ -0,0 +1,28 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+#include <string>
+#include <cstddef>
+
+namespace GraphLib {
+    class MappedFile {
+        const char *data;
+        size_t length;
+
+    public:
+        explicit MappedFile(const std::string &file_path);
+
+        MappedFile(const MappedFile &) = delete;
+
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        ~MappedFile();
+
+        const char *begin() const;
+
+        const char *end() const;
+
+        size_t size() const;
+    };
+}
+
+#endif
@@ -0,0 +1,99 @@
+#include "Metrics.h"
+#include <sys/resource.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+namespace GraphLib {
+    namespace {
+#ifdef __linux__
+        int open_counter(const uint64_t config) {
+            perf_event_attr attr{};
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.size = sizeof(attr);
+            attr.config = config;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.inherit = 1;
+            const int fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+            if (fd >= 0) {
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+            return fd;
+        }
+#endif
+
+        uint64_t read_counter(const int fd) {
+            uint64_t value = 0;
+            if (fd >= 0 && ::read(fd, &value, sizeof(value)) != sizeof(value)) {
+                value = 0;
+            }
+            return value;
+        }
+    }
+
+    PerfCounters::PerfCounters() : cache_fd(-1), branch_fd(-1) {
+#ifdef __linux__
+        cache_fd = open_counter(PERF_COUNT_HW_CACHE_MISSES);
+        branch_fd = open_counter(PERF_COUNT_HW_BRANCH_MISSES);
+#endif
+    }
+
+    PerfCounters::~PerfCounters() {
+        if (cache_fd >= 0) {
+            close(cache_fd);
+        }
+        if (branch_fd >= 0) {
+            close(branch_fd);
+        }
+    }
+
+    bool PerfCounters::available() const {
+        return cache_fd >= 0 && branch_fd >= 0;
+    }
+
+    void PerfCounters::read(uint64_t &cache_misses, uint64_t &branch_misses) const {
+        cache_misses = read_counter(cache_fd);
+        branch_misses = read_counter(branch_fd);
+    }
+
+    PhaseRecorder::PhaseRecorder(const bool hardware_counters) : start_cache_misses(0), start_branch_misses(0) {
+        if (hardware_counters) {
+            counters = std::make_unique<PerfCounters>();
+            if (!counters->available()) {
+                counters.reset();
+            }
+        }
+    }
+
+    void PhaseRecorder::begin() {
+        if (counters) {
+            counters->read(start_cache_misses, start_branch_misses);
+        }
+        start = std::chrono::high_resolution_clock::now();
+    }
+
+    void PhaseRecorder::end(PhaseMetrics &phase) const {
+        const std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+        phase.time += elapsed.count();
+        if (counters) {
+            uint64_t cache_misses, branch_misses;
+            counters->read(cache_misses, branch_misses);
+            phase.hardware_counters = true;
+            phase.cache_misses += cache_misses - start_cache_misses;
+            phase.branch_misses += branch_misses - start_branch_misses;
+        }
+    }
+
+    size_t peak_memory_usage() {
+        rusage usage{};
+        if (getrusage(RUSAGE_SELF, &usage) != 0) {
+            return 0;
+        }
+        return static_cast<size_t>(usage.ru_maxrss) * 1024;
+    }
+}
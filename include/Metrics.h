@@ -0,0 +1,63 @@
+#ifndef METRICS_H
+#define METRICS_H
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace GraphLib {
+    enum class MSTEngine;
+
+    struct PhaseMetrics {
+        double time = 0.0;
+        bool hardware_counters = false;
+        uint64_t cache_misses = 0;
+        uint64_t branch_misses = 0;
+    };
+
+    struct MSTMetrics {
+        PhaseMetrics load, sort, loop, output;
+        uint64_t finds = 0;
+        uint64_t compression_hops = 0;
+        uint64_t unions = 0;
+        uint64_t edges_scanned = 0;
+        size_t peak_memory = 0;
+        size_t scratch_memory = 0;
+        MSTEngine engine{};
+        bool from_cache = false;
+    };
+
+    class PerfCounters {
+        int cache_fd, branch_fd;
+
+    public:
+        PerfCounters();
+
+        PerfCounters(const PerfCounters &) = delete;
+
+        PerfCounters &operator=(const PerfCounters &) = delete;
+
+        ~PerfCounters();
+
+        bool available() const;
+
+        void read(uint64_t &cache_misses, uint64_t &branch_misses) const;
+    };
+
+    class PhaseRecorder {
+        std::unique_ptr<PerfCounters> counters;
+        std::chrono::high_resolution_clock::time_point start;
+        uint64_t start_cache_misses, start_branch_misses;
+
+    public:
+        explicit PhaseRecorder(bool hardware_counters = false);
+
+        void begin();
+
+        void end(PhaseMetrics &phase) const;
+    };
+
+    size_t peak_memory_usage();
+}
+
+#endif
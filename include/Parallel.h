@@ -0,0 +1,44 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace GraphLib {
+    inline unsigned resolve_threads(const unsigned threads) {
+        return threads != 0 ? threads : std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    template<typename F>
+    void parallel_run(const unsigned threads, F &&body) {
+        std::vector<std::thread> workers;
+        workers.reserve(threads - 1);
+        for (unsigned t = 1; t < threads; t++) {
+            workers.emplace_back([&body, t] {
+                body(t);
+            });
+        }
+        body(0u);
+        for (std::thread &worker: workers) {
+            worker.join();
+        }
+    }
+
+    template<typename F>
+    void parallel_for(const unsigned threads, const size_t n, F &&body) {
+        const size_t chunks_size = std::clamp<size_t>(n, 1, threads);
+        std::vector<std::thread> workers;
+        workers.reserve(chunks_size - 1);
+        for (size_t t = 1; t < chunks_size; t++) {
+            workers.emplace_back([&body, t, n, chunks_size] {
+                body(n * t / chunks_size, n * (t + 1) / chunks_size);
+            });
+        }
+        body(0, n / chunks_size);
+        for (std::thread &worker: workers) {
+            worker.join();
+        }
+    }
+}
+
+#endif
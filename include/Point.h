@@ -1,5 +1,6 @@
 #ifndef POINT_H
 #define POINT_H
+#include <cstddef>
 
 namespace GraphLib {
     struct Point {
@@ -11,10 +12,20 @@ namespace GraphLib {
     };
 
     struct Pair {
-        Point *first, *second;
+        Point first, second;
         double weight;
 
-        Pair(Point *first, Point *second, const double weight = 1.0) : first(first), second(second), weight(weight) {
+        Pair(const Point &first, const Point &second, const double weight = 1.0) : first(first), second(second),
+            weight(weight) {
+        }
+    };
+
+    struct Edge {
+        size_t first, second;
+        double weight;
+
+        Edge(const size_t first, const size_t second, const double weight = 1.0) : first(first), second(second),
+            weight(weight) {
         }
     };
 }
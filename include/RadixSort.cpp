@@ -0,0 +1,163 @@
+#include "RadixSort.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <array>
+#include <barrier>
+#include <bit>
+
+namespace GraphLib {
+    namespace {
+        constexpr int digit_bits = 8;
+        constexpr int digits_size = 64 / digit_bits;
+        constexpr size_t radix = 1 << digit_bits;
+        constexpr size_t small_sort_size = 256;
+        constexpr size_t min_items_per_thread = 1 << 16;
+
+        using Histogram = std::array<size_t, radix>;
+    }
+
+    uint64_t weight_key(const double weight) {
+        const uint64_t bits = weight == 0.0 ? 0 : std::bit_cast<uint64_t>(weight);
+        return bits >> 63 ? ~bits : bits | 1ULL << 63;
+    }
+
+    double key_weight(const uint64_t key) {
+        return std::bit_cast<double>(key >> 63 ? key & ~(1ULL << 63) : ~key);
+    }
+
+    void radix_sort(const std::span<SortItem> items, const std::span<SortItem> buffer) {
+        const size_t n = items.size();
+        if (n < small_sort_size) {
+            std::sort(items.begin(), items.end(), [](const SortItem &a, const SortItem &b) {
+                return a.key < b.key || (a.key == b.key && a.index < b.index);
+            });
+            return;
+        }
+
+        std::array<std::array<size_t, radix>, digits_size> counts{};
+        for (const SortItem &item: items) {
+            for (int d = 0; d < digits_size; d++) {
+                counts[d][item.key >> (d * digit_bits) & (radix - 1)]++;
+            }
+        }
+
+        std::span<SortItem> from = items, to = buffer.first(n);
+        for (int d = 0; d < digits_size; d++) {
+            const int shift = d * digit_bits;
+            if (counts[d][from[0].key >> shift & (radix - 1)] == n) {
+                continue;
+            }
+
+            size_t offset = 0;
+            for (size_t &count: counts[d]) {
+                const size_t bucket_size = count;
+                count = offset;
+                offset += bucket_size;
+            }
+            for (const SortItem &item: from) {
+                to[counts[d][item.key >> shift & (radix - 1)]++] = item;
+            }
+            std::swap(from, to);
+        }
+
+        if (from.data() != items.data()) {
+            std::copy(from.begin(), from.end(), items.begin());
+        }
+    }
+
+    void parallel_radix_sort(const std::span<SortItem> items, const std::span<SortItem> buffer, unsigned threads) {
+        const size_t n = items.size();
+        threads = static_cast<unsigned>(std::min<size_t>(resolve_threads(threads), n / min_items_per_thread));
+        if (threads <= 1) {
+            radix_sort(items, buffer);
+            return;
+        }
+
+        std::vector<std::array<Histogram, digits_size> > thread_totals(threads);
+        std::vector<Histogram> thread_counts(threads);
+        std::barrier sync(threads);
+
+        const auto worker = [&](const unsigned t) {
+            const size_t first = n * t / threads;
+            const size_t last = n * (t + 1) / threads;
+            std::array<Histogram, digits_size> &totals = thread_totals[t];
+            totals = {};
+            for (size_t i = first; i < last; i++) {
+                for (int d = 0; d < digits_size; d++) {
+                    totals[d][items[i].key >> (d * digit_bits) & (radix - 1)]++;
+                }
+            }
+            sync.arrive_and_wait();
+
+            std::span<SortItem> from = items, to = buffer.first(n);
+            for (int d = 0; d < digits_size; d++) {
+                const int shift = d * digit_bits;
+                bool single_bucket = false;
+                for (size_t b = 0; b < radix && !single_bucket; b++) {
+                    size_t bucket_size = 0;
+                    for (unsigned other = 0; other < threads; other++) {
+                        bucket_size += thread_totals[other][d][b];
+                    }
+                    single_bucket = bucket_size == n;
+                }
+                if (single_bucket) {
+                    continue;
+                }
+
+                Histogram &counts = thread_counts[t];
+                counts = {};
+                for (size_t i = first; i < last; i++) {
+                    counts[from[i].key >> shift & (radix - 1)]++;
+                }
+                sync.arrive_and_wait();
+
+                Histogram offsets{};
+                size_t offset = 0;
+                for (size_t b = 0; b < radix; b++) {
+                    for (unsigned other = 0; other < threads; other++) {
+                        if (other == t) {
+                            offsets[b] = offset;
+                        }
+                        offset += thread_counts[other][b];
+                    }
+                }
+                for (size_t i = first; i < last; i++) {
+                    to[offsets[from[i].key >> shift & (radix - 1)]++] = from[i];
+                }
+                sync.arrive_and_wait();
+                std::swap(from, to);
+            }
+
+            if (from.data() != items.data()) {
+                std::copy(from.begin() + static_cast<std::ptrdiff_t>(first),
+                          from.begin() + static_cast<std::ptrdiff_t>(last),
+                          items.begin() + static_cast<std::ptrdiff_t>(first));
+            }
+        };
+
+        parallel_run(threads, worker);
+    }
+
+    void radix_sort_edges(const std::span<const double> weights, std::vector<SortItem> &buffer,
+                          std::vector<size_t> &sorted_edges, unsigned threads) {
+        const size_t n = weights.size();
+        threads = static_cast<unsigned>(std::clamp<size_t>(n / min_items_per_thread, 1, resolve_threads(threads)));
+        buffer.resize(2 * n);
+        sorted_edges.resize(n);
+        const std::span<SortItem> items(buffer.data(), n);
+
+        parallel_for(threads, n, [&](const size_t first, const size_t last) {
+            for (size_t i = first; i < last; i++) {
+                items[i] = {weight_key(weights[i]), i};
+            }
+        });
+
+        parallel_radix_sort(items, std::span(buffer).subspan(n), threads);
+
+        parallel_for(threads, n, [&](const size_t first, const size_t last) {
+            for (size_t i = first; i < last; i++) {
+                sorted_edges[i] = items[i].index;
+            }
+        });
+    }
+}
@@ -0,0 +1,25 @@
+#ifndef RADIXSORT_H
+#define RADIXSORT_H
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace GraphLib {
+    struct SortItem {
+        uint64_t key;
+        size_t index;
+    };
+
+    uint64_t weight_key(double weight);
+
+    double key_weight(uint64_t key);
+
+    void radix_sort(std::span<SortItem> items, std::span<SortItem> buffer);
+
+    void parallel_radix_sort(std::span<SortItem> items, std::span<SortItem> buffer, unsigned threads);
+
+    void radix_sort_edges(std::span<const double> weights, std::vector<SortItem> &buffer,
+                          std::vector<size_t> &sorted_edges, unsigned threads = 1);
+}
+
+#endif
@@ -0,0 +1,395 @@
+#include "Renderer.h"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <unordered_set>
+
+namespace GraphLib {
+    namespace {
+        constexpr double margin = 16.0;
+        constexpr size_t flush_threshold = 1 << 20;
+        constexpr size_t stored_block_limit = 65535;
+
+        struct Segment {
+            float x1, y1, x2, y2;
+        };
+
+        // Projection of the graph's bounding box onto the image, preserving aspect ratio with y pointing up.
+        struct Viewport {
+            std::vector<float> x, y;
+
+            Viewport(const Graph &graph, const RenderOptions &options) : x(graph.points_size()),
+                                                                         y(graph.points_size()) {
+                if (options.width == 0 || options.height == 0 || options.width > 65535 || options.height > 65535) {
+                    throw std::invalid_argument("Render size must be between 1 and 65535 pixels");
+                }
+                double min_x = 0.0, min_y = 0.0, max_x = 0.0, max_y = 0.0;
+                for (size_t i = 0; i < graph.points_size(); i++) {
+                    const Point point = graph.get_point(i);
+                    if (i == 0) {
+                        min_x = max_x = point.x;
+                        min_y = max_y = point.y;
+                    }
+                    min_x = std::min(min_x, point.x);
+                    max_x = std::max(max_x, point.x);
+                    min_y = std::min(min_y, point.y);
+                    max_y = std::max(max_y, point.y);
+                }
+
+                const double inner_width = std::max(1.0, options.width - 2 * margin);
+                const double inner_height = std::max(1.0, options.height - 2 * margin);
+                const double span = std::max(max_x - min_x, max_y - min_y);
+                const double scale = span > 0.0 ? std::min(inner_width, inner_height) / span : 0.0;
+                const double offset_x = (options.width - (max_x - min_x) * scale) / 2;
+                const double offset_y = (options.height - (max_y - min_y) * scale) / 2;
+                for (size_t i = 0; i < graph.points_size(); i++) {
+                    const Point point = graph.get_point(i);
+                    x[i] = static_cast<float>(offset_x + (point.x - min_x) * scale);
+                    y[i] = static_cast<float>(options.height - offset_y - (point.y - min_y) * scale);
+                }
+            }
+
+            static uint32_t pixel_key(const float x, const float y) {
+                return static_cast<uint32_t>(std::lround(x)) << 16 | static_cast<uint32_t>(std::lround(y));
+            }
+        };
+
+        // Edges collapsing to a single pixel or repeating an already drawn pixel segment are culled; what remains is
+        // thinned with an even stride so that huge graphs stay within edges_limit.
+        std::vector<Segment> collect_segments(const Graph &graph, const Viewport &viewport,
+                                              const std::vector<size_t> &edges, const size_t limit,
+                                              RenderStats &stats) {
+            std::vector<Segment> segments;
+            std::unordered_set<uint64_t> seen;
+            const auto add = [&](const size_t edge) {
+                const Pair pair = graph.get_edge(edge);
+                const size_t a = pair.first.index, b = pair.second.index;
+                const uint32_t key_a = Viewport::pixel_key(viewport.x[a], viewport.y[a]);
+                const uint32_t key_b = Viewport::pixel_key(viewport.x[b], viewport.y[b]);
+                if (key_a == key_b) {
+                    stats.edges_culled++;
+                    return;
+                }
+                const uint64_t low = std::min(key_a, key_b), high = std::max(key_a, key_b);
+                if (!seen.insert(low << 32 | high).second) {
+                    stats.edges_culled++;
+                    return;
+                }
+                segments.push_back({viewport.x[a], viewport.y[a], viewport.x[b], viewport.y[b]});
+            };
+            if (edges.empty()) {
+                for (size_t i = 0; i < graph.edges_size(); i++) {
+                    add(i);
+                }
+            } else {
+                for (const size_t edge: edges) {
+                    add(edge);
+                }
+            }
+
+            if (segments.size() > limit && limit > 0) {
+                const size_t stride = (segments.size() + limit - 1) / limit;
+                size_t kept = 0;
+                for (size_t i = 0; i < segments.size(); i += stride) {
+                    segments[kept++] = segments[i];
+                }
+                stats.edges_culled += segments.size() - kept;
+                segments.resize(kept);
+            }
+            return segments;
+        }
+
+        std::vector<size_t> visible_points(const Viewport &viewport) {
+            std::vector<size_t> points;
+            std::unordered_set<uint32_t> seen;
+            for (size_t i = 0; i < viewport.x.size(); i++) {
+                if (seen.insert(Viewport::pixel_key(viewport.x[i], viewport.y[i])).second) {
+                    points.push_back(i);
+                }
+            }
+            return points;
+        }
+
+        class BufferedWriter {
+            std::ofstream file;
+            std::string buffer;
+
+        public:
+            explicit BufferedWriter(const std::string &file_path) : file(file_path, std::ios::binary | std::ios::trunc) {
+                if (!file.is_open()) {
+                    throw std::runtime_error("Unable to open file from: " + file_path);
+                }
+                buffer.reserve(flush_threshold + 256);
+            }
+
+            BufferedWriter &operator<<(const std::string_view text) {
+                buffer.append(text);
+                if (buffer.size() >= flush_threshold) {
+                    flush();
+                }
+                return *this;
+            }
+
+            BufferedWriter &operator<<(const size_t value) {
+                char digits[24];
+                const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+                return *this << std::string_view(digits, result.ptr - digits);
+            }
+
+            BufferedWriter &operator<<(const float value) {
+                char digits[32];
+                const auto result = std::to_chars(digits, digits + sizeof(digits), value, std::chars_format::fixed, 1);
+                return *this << std::string_view(digits, result.ptr - digits);
+            }
+
+            void flush() {
+                file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+                buffer.clear();
+            }
+
+            void close(const std::string &file_path) {
+                flush();
+                file.close();
+                if (!file) {
+                    throw std::runtime_error("Unable to write file to: " + file_path);
+                }
+            }
+        };
+
+        void write_svg_path(BufferedWriter &out, const std::vector<Segment> &segments, const std::string_view stroke,
+                            const std::string_view width) {
+            if (segments.empty()) {
+                return;
+            }
+            out << "<path fill=\"none\" stroke=\"" << stroke << "\" stroke-width=\"" << width << "\" d=\"";
+            for (const Segment &segment: segments) {
+                out << "M" << segment.x1 << " " << segment.y1 << "L" << segment.x2 << " " << segment.y2;
+            }
+            out << "\"/>\n";
+        }
+
+        class Raster {
+            unsigned width, height;
+            std::vector<uint8_t> pixels;
+
+        public:
+            using Color = std::array<uint8_t, 3>;
+
+            Raster(const unsigned width, const unsigned height) : width(width), height(height),
+                                                                  pixels(static_cast<size_t>(width) * height * 3, 255) {
+            }
+
+            void plot(const long x, const long y, const Color &color) {
+                if (x < 0 || y < 0 || x >= static_cast<long>(width) || y >= static_cast<long>(height)) {
+                    return;
+                }
+                std::copy(color.begin(), color.end(), pixels.begin() + (static_cast<size_t>(y) * width + x) * 3);
+            }
+
+            void line(const Segment &segment, const Color &color, const bool thick) {
+                long x0 = std::lround(segment.x1), y0 = std::lround(segment.y1);
+                const long x1 = std::lround(segment.x2), y1 = std::lround(segment.y2);
+                const long dx = std::abs(x1 - x0), dy = -std::abs(y1 - y0);
+                const long sx = x0 < x1 ? 1 : -1, sy = y0 < y1 ? 1 : -1;
+                long error = dx + dy;
+                while (true) {
+                    plot(x0, y0, color);
+                    if (thick) {
+                        plot(x0 + 1, y0, color);
+                        plot(x0, y0 + 1, color);
+                    }
+                    if (x0 == x1 && y0 == y1) {
+                        break;
+                    }
+                    const long doubled = 2 * error;
+                    if (doubled >= dy) {
+                        error += dy;
+                        x0 += sx;
+                    }
+                    if (doubled <= dx) {
+                        error += dx;
+                        y0 += sy;
+                    }
+                }
+            }
+
+            void dot(const float x, const float y, const Color &color) {
+                const long cx = std::lround(x), cy = std::lround(y);
+                for (long oy = -1; oy <= 1; oy++) {
+                    for (long ox = -1; ox <= 1; ox++) {
+                        plot(cx + ox, cy + oy, color);
+                    }
+                }
+            }
+
+            // Scanlines use filter type 0 and are wrapped in stored deflate blocks, so no compression library is needed.
+            std::vector<uint8_t> encode_png() const {
+                std::vector<uint8_t> raw;
+                const size_t stride = static_cast<size_t>(width) * 3;
+                raw.reserve((stride + 1) * height);
+                for (unsigned row = 0; row < height; row++) {
+                    raw.push_back(0);
+                    raw.insert(raw.end(), pixels.begin() + row * stride, pixels.begin() + (row + 1) * stride);
+                }
+
+                std::vector<uint8_t> zlib = {0x78, 0x01};
+                zlib.reserve(raw.size() + raw.size() / stored_block_limit * 5 + 16);
+                size_t position = 0;
+                do {
+                    const size_t length = std::min(stored_block_limit, raw.size() - position);
+                    zlib.push_back(position + length == raw.size() ? 1 : 0);
+                    zlib.push_back(length & 0xFF);
+                    zlib.push_back(length >> 8 & 0xFF);
+                    zlib.push_back(~length & 0xFF);
+                    zlib.push_back(~length >> 8 & 0xFF);
+                    zlib.insert(zlib.end(), raw.begin() + position, raw.begin() + position + length);
+                    position += length;
+                } while (position < raw.size());
+
+                uint32_t a = 1, b = 0;
+                for (const uint8_t byte: raw) {
+                    a = (a + byte) % 65521;
+                    b = (b + a) % 65521;
+                }
+                append_u32(zlib, b << 16 | a);
+
+                std::vector<uint8_t> png = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+                std::vector<uint8_t> header;
+                append_u32(header, width);
+                append_u32(header, height);
+                // 8-bit RGB, deflate, adaptive filtering, no interlace.
+                for (const uint8_t field: {8, 2, 0, 0, 0}) {
+                    header.push_back(field);
+                }
+                append_chunk(png, "IHDR", header);
+                append_chunk(png, "IDAT", zlib);
+                append_chunk(png, "IEND", {});
+                return png;
+            }
+
+        private:
+            static void append_u32(std::vector<uint8_t> &out, const uint32_t value) {
+                for (int shift = 24; shift >= 0; shift -= 8) {
+                    out.push_back(static_cast<uint8_t>(value >> shift));
+                }
+            }
+
+            static uint32_t crc32(const uint8_t *data, const size_t size, uint32_t crc) {
+                static const std::array<uint32_t, 256> table = [] {
+                    std::array<uint32_t, 256> result{};
+                    for (uint32_t i = 0; i < 256; i++) {
+                        uint32_t c = i;
+                        for (int k = 0; k < 8; k++) {
+                            c = c & 1 ? 0xEDB88320U ^ c >> 1 : c >> 1;
+                        }
+                        result[i] = c;
+                    }
+                    return result;
+                }();
+                for (size_t i = 0; i < size; i++) {
+                    crc = table[(crc ^ data[i]) & 0xFF] ^ crc >> 8;
+                }
+                return crc;
+            }
+
+            static void append_chunk(std::vector<uint8_t> &out, const char *type, const std::vector<uint8_t> &data) {
+                append_u32(out, static_cast<uint32_t>(data.size()));
+                const size_t start = out.size();
+                out.insert(out.end(), type, type + 4);
+                out.insert(out.end(), data.begin(), data.end());
+                append_u32(out, crc32(out.data() + start, out.size() - start, 0xFFFFFFFFU) ^ 0xFFFFFFFFU);
+            }
+        };
+
+        struct Layers {
+            std::vector<Segment> edges, mst;
+            std::vector<size_t> points;
+        };
+
+        Layers build_layers(const Graph &graph, const Viewport &viewport, const RenderOptions &options,
+                            RenderStats &stats) {
+            Layers layers;
+            if (options.with_edges && graph.edges_size() > 0) {
+                layers.edges = collect_segments(graph, viewport, {}, options.edges_limit, stats);
+            }
+            if (options.with_mst && graph.edges_size() > 0) {
+                const std::vector<size_t> mst = graph.get_MST(options.mst_options);
+                if (!mst.empty()) {
+                    RenderStats mst_stats;
+                    layers.mst = collect_segments(graph, viewport, mst, 0, mst_stats);
+                }
+            }
+            if (options.with_points) {
+                layers.points = visible_points(viewport);
+            }
+            stats.edges_drawn = layers.edges.size();
+            stats.mst_edges_drawn = layers.mst.size();
+            stats.points_drawn = layers.points.size();
+            return layers;
+        }
+    }
+
+    RenderStats render_svg(const Graph &graph, const std::string &file_path, const RenderOptions &options) {
+        const Viewport viewport(graph, options);
+        RenderStats stats;
+        const Layers layers = build_layers(graph, viewport, options, stats);
+
+        BufferedWriter out(file_path);
+        out << "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"" << static_cast<size_t>(options.width)
+                << "\" height=\"" << static_cast<size_t>(options.height) << "\" viewBox=\"0 0 "
+                << static_cast<size_t>(options.width) << " " << static_cast<size_t>(options.height) << "\">\n"
+                << "<rect width=\"100%\" height=\"100%\" fill=\"white\"/>\n";
+        write_svg_path(out, layers.edges, "lightgray", "0.5");
+        write_svg_path(out, layers.mst, "red", "1.5");
+        if (!layers.points.empty()) {
+            out << "<g fill=\"blue\">\n";
+            for (const size_t point: layers.points) {
+                out << "<circle cx=\"" << viewport.x[point] << "\" cy=\"" << viewport.y[point] << "\" r=\"2\"/>\n";
+            }
+            out << "</g>\n";
+            if (graph.points_size() <= options.labels_limit) {
+                out << "<g font-family=\"sans-serif\" font-size=\"10\" fill=\"black\">\n";
+                for (const size_t point: layers.points) {
+                    out << "<text x=\"" << viewport.x[point] + 3.0f << "\" y=\"" << viewport.y[point] - 3.0f << "\">"
+                            << point << "</text>\n";
+                }
+                out << "</g>\n";
+            }
+        }
+        out << "</svg>\n";
+        out.close(file_path);
+        return stats;
+    }
+
+    RenderStats render_png(const Graph &graph, const std::string &file_path, const RenderOptions &options) {
+        const Viewport viewport(graph, options);
+        RenderStats stats;
+        const Layers layers = build_layers(graph, viewport, options, stats);
+
+        Raster raster(options.width, options.height);
+        for (const Segment &segment: layers.edges) {
+            raster.line(segment, {211, 211, 211}, false);
+        }
+        for (const Segment &segment: layers.mst) {
+            raster.line(segment, {255, 0, 0}, true);
+        }
+        for (const size_t point: layers.points) {
+            raster.dot(viewport.x[point], viewport.y[point], {0, 0, 255});
+        }
+
+        const std::vector<uint8_t> png = raster.encode_png();
+        std::ofstream file(file_path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            throw std::runtime_error("Unable to open file from: " + file_path);
+        }
+        file.write(reinterpret_cast<const char *>(png.data()), static_cast<std::streamsize>(png.size()));
+        if (!file) {
+            throw std::runtime_error("Unable to write file to: " + file_path);
+        }
+        return stats;
+    }
+}
@@ -0,0 +1,33 @@
+#ifndef RENDERER_H
+#define RENDERER_H
+#include "Graph.h"
+#include <string>
+
+namespace GraphLib {
+    struct RenderOptions {
+        unsigned width = 1024;
+        unsigned height = 1024;
+        bool with_edges = true;
+        bool with_mst = true;
+        bool with_points = true;
+        // Point indices are written next to the points in SVG output only for graphs up to this size.
+        size_t labels_limit = 200;
+        // Edges left after dropping sub-pixel and duplicate segments are sampled down to this count; 0 keeps all. The MST
+        // layer is never sampled, so it stays complete however dense the rest of the graph is.
+        size_t edges_limit = 250000;
+        MSTOptions mst_options;
+    };
+
+    struct RenderStats {
+        size_t points_drawn = 0;
+        size_t edges_drawn = 0;
+        size_t mst_edges_drawn = 0;
+        size_t edges_culled = 0;
+    };
+
+    RenderStats render_svg(const Graph &graph, const std::string &file_path, const RenderOptions &options = {});
+
+    RenderStats render_png(const Graph &graph, const std::string &file_path, const RenderOptions &options = {});
+}
+
+#endif
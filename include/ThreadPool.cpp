@@ -0,0 +1,109 @@
+#include "ThreadPool.h"
+#include "Parallel.h"
+
+namespace GraphLib {
+    ThreadPool::ThreadPool(const unsigned threads) : queued_size(0), pending_size(0), next_queue(0), stopping(false) {
+        const unsigned workers_size = resolve_threads(threads);
+        queues.reserve(workers_size);
+        for (unsigned i = 0; i < workers_size; i++) {
+            queues.push_back(std::make_unique<Queue>());
+        }
+        workers.reserve(workers_size);
+        for (unsigned i = 0; i < workers_size; i++) {
+            workers.emplace_back([this, i] {
+                run_worker(i);
+            });
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            const std::lock_guard lock(mutex);
+            stopping = true;
+        }
+        work_ready.notify_all();
+        for (std::thread &worker: workers) {
+            worker.join();
+        }
+    }
+
+    unsigned ThreadPool::size() const {
+        return static_cast<unsigned>(workers.size());
+    }
+
+    void ThreadPool::submit(Task task) {
+        size_t queue;
+        {
+            const std::lock_guard lock(mutex);
+            queue = next_queue++ % queues.size();
+            pending_size++;
+            queued_size++;
+        }
+        {
+            const std::lock_guard lock(queues[queue]->mutex);
+            queues[queue]->tasks.push_back(std::move(task));
+        }
+        work_ready.notify_one();
+    }
+
+    void ThreadPool::wait() {
+        std::unique_lock lock(mutex);
+        work_done.wait(lock, [this] {
+            return pending_size == 0;
+        });
+    }
+
+    // A worker takes the oldest task of its own queue and otherwise steals the newest task of another queue, so the
+    // owner and the thief work from opposite ends.
+    bool ThreadPool::pop_task(const unsigned worker, Task &task) {
+        {
+            Queue &own = *queues[worker];
+            const std::lock_guard lock(own.mutex);
+            if (!own.tasks.empty()) {
+                task = std::move(own.tasks.front());
+                own.tasks.pop_front();
+                return true;
+            }
+        }
+        for (size_t i = 1; i < queues.size(); i++) {
+            Queue &other = *queues[(worker + i) % queues.size()];
+            const std::lock_guard lock(other.mutex);
+            if (!other.tasks.empty()) {
+                task = std::move(other.tasks.back());
+                other.tasks.pop_back();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void ThreadPool::run_worker(const unsigned worker) {
+        while (true) {
+            Task task;
+            if (pop_task(worker, task)) {
+                {
+                    const std::lock_guard lock(mutex);
+                    queued_size--;
+                }
+                task(worker);
+                bool done;
+                {
+                    const std::lock_guard lock(mutex);
+                    done = --pending_size == 0;
+                }
+                if (done) {
+                    work_done.notify_all();
+                }
+                continue;
+            }
+
+            std::unique_lock lock(mutex);
+            work_ready.wait(lock, [this] {
+                return queued_size > 0 || stopping;
+            });
+            if (queued_size == 0 && stopping) {
+                return;
+            }
+        }
+    }
+}
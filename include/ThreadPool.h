@@ -0,0 +1,51 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace GraphLib {
+    class ThreadPool {
+    public:
+        using Task = std::function<void(unsigned worker)>;
+
+    private:
+        struct Queue {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        std::vector<std::unique_ptr<Queue> > queues;
+        std::vector<std::thread> workers;
+
+        std::mutex mutex;
+        std::condition_variable work_ready, work_done;
+        size_t queued_size, pending_size, next_queue;
+        bool stopping;
+
+        bool pop_task(unsigned worker, Task &task);
+
+        void run_worker(unsigned worker);
+
+    public:
+        explicit ThreadPool(unsigned threads = 0);
+
+        ThreadPool(const ThreadPool &) = delete;
+
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        ~ThreadPool();
+
+        unsigned size() const;
+
+        void submit(Task task);
+
+        void wait();
+    };
+}
+
+#endif
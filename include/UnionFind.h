@@ -1,27 +1,179 @@
 #ifndef UNIONFIND_H
 #define UNIONFIND_H
+#include <cstddef>
+#include <utility>
+#include <vector>
 
 namespace GraphLib {
+    enum class FindPolicy {
+        None,
+        Compression,
+        Halving,
+        Splitting
+    };
+
+    enum class UnionPolicy {
+        Naive,
+        Rank,
+        Size
+    };
+
+    struct OperationCounts {
+        size_t finds = 0;
+        size_t hops = 0;
+        size_t unions = 0;
+        size_t scans = 0;
+    };
+
+    struct NoCounter {
+        void find() {
+        }
+
+        void hop() {
+        }
+
+        void unite() {
+        }
+
+        void scan() {
+        }
+
+        OperationCounts get() const {
+            return {};
+        }
+    };
+
+    struct OperationCounter {
+        OperationCounts counts;
+
+        void find() {
+            counts.finds++;
+        }
+
+        void hop() {
+            counts.hops++;
+        }
+
+        void unite() {
+            counts.unions++;
+        }
+
+        void scan() {
+            counts.scans++;
+        }
+
+        OperationCounts get() const {
+            return counts;
+        }
+    };
+
+    struct UnionFindStorage {
+        std::vector<size_t> parent;
+        std::vector<size_t> rank;
+    };
+
+    template<FindPolicy Find = FindPolicy::Compression, UnionPolicy Union = UnionPolicy::Rank,
+        typename Counter = NoCounter>
     class UnionFind {
-        int *parent;
-        int *rank;
+        std::vector<size_t> parent;
+        std::vector<size_t> rank;
 
-        int find_calls;
+        [[no_unique_address]] Counter counter;
 
     public:
-        explicit UnionFind(int n);
+        explicit UnionFind(const size_t n, UnionFindStorage storage = {}) : parent(std::move(storage.parent)),
+                                                                            rank(std::move(storage.rank)) {
+            parent.resize(n);
+            for (size_t i = 0; i < n; i++) {
+                parent[i] = i;
+            }
+            if constexpr (Union == UnionPolicy::Rank) {
+                rank.assign(n, 0);
+            } else if constexpr (Union == UnionPolicy::Size) {
+                rank.assign(n, 1);
+            } else {
+                rank.clear();
+            }
+        }
 
-        ~UnionFind();
+        UnionFindStorage release() {
+            return {std::move(parent), std::move(rank)};
+        }
 
-        int get_find_calls() const;
+        Counter &get_counter() {
+            return counter;
+        }
 
-        int find(int node);
+        OperationCounts get_counts() const {
+            return counter.get();
+        }
 
-        int compress_find(int node);
+        size_t get_find_calls() const {
+            const OperationCounts counts = counter.get();
+            return counts.finds + counts.hops;
+        }
 
-        void unite(int root_x, int root_y);
+        size_t find(size_t node) {
+            counter.find();
+            if constexpr (Find == FindPolicy::None) {
+                while (node != parent[node]) {
+                    counter.hop();
+                    node = parent[node];
+                }
+                return node;
+            } else if constexpr (Find == FindPolicy::Compression) {
+                size_t root = node;
+                while (root != parent[root]) {
+                    counter.hop();
+                    root = parent[root];
+                }
+                while (node != root) {
+                    const size_t next = parent[node];
+                    parent[node] = root;
+                    node = next;
+                }
+                return root;
+            } else if constexpr (Find == FindPolicy::Halving) {
+                while (node != parent[node]) {
+                    counter.hop();
+                    parent[node] = parent[parent[node]];
+                    node = parent[node];
+                }
+                return node;
+            } else {
+                while (node != parent[node]) {
+                    counter.hop();
+                    const size_t next = parent[node];
+                    parent[node] = parent[next];
+                    node = next;
+                }
+                return node;
+            }
+        }
 
-        void rank_unite(int root_x, int root_y);
+        void unite(const size_t root_x, const size_t root_y) {
+            counter.unite();
+            if constexpr (Union == UnionPolicy::Naive) {
+                parent[root_x] = root_y;
+            } else if constexpr (Union == UnionPolicy::Rank) {
+                if (rank[root_x] < rank[root_y]) {
+                    parent[root_x] = root_y;
+                } else if (rank[root_x] > rank[root_y]) {
+                    parent[root_y] = root_x;
+                } else {
+                    parent[root_y] = root_x;
+                    rank[root_x]++;
+                }
+            } else {
+                if (rank[root_x] < rank[root_y]) {
+                    parent[root_x] = root_y;
+                    rank[root_y] += rank[root_x];
+                } else {
+                    parent[root_y] = root_x;
+                    rank[root_x] += rank[root_y];
+                }
+            }
+        }
     };
 }
 
@@ -0,0 +1,328 @@
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../include/Graph.h"
+#include "../include/GraphGenerator.h"
+#include "../include/Parallel.h"
+
+namespace {
+    constexpr size_t max_dense_points = 20000;
+
+    struct Settings {
+        std::vector<GraphLib::GraphKind> kinds = {
+            GraphLib::GraphKind::Random, GraphLib::GraphKind::Geometric, GraphLib::GraphKind::Grid,
+            GraphLib::GraphKind::NearComplete, GraphLib::GraphKind::Chain
+        };
+        std::vector<std::string> variants;
+        size_t min_edges = 1000;
+        size_t max_edges = 1000000;
+        int warmup = 1;
+        int trials = 5;
+        uint64_t seed = 42;
+        unsigned threads = 0;
+        std::string format = "text";
+        std::string output;
+    };
+
+    struct Variant {
+        std::string name;
+        GraphLib::MSTOptions options;
+    };
+
+    struct Stats {
+        double median, p95;
+    };
+
+    struct Result {
+        std::string kind, variant, engine;
+        size_t points_size, edges_size, mst_size;
+        double mst_weight;
+        bool matches;
+        Stats sort, loop, total;
+        double edges_per_second;
+        uint64_t finds, unions, edges_scanned;
+        size_t peak_memory, scratch_memory;
+    };
+
+    std::vector<std::string> split(const std::string &text) {
+        std::vector<std::string> items;
+        std::stringstream stream(text);
+        std::string item;
+        while (std::getline(stream, item, ',')) {
+            if (!item.empty()) {
+                items.push_back(item);
+            }
+        }
+        return items;
+    }
+
+    Settings parse_settings(const int argc, char *argv[]) {
+        Settings settings;
+        for (int i = 1; i < argc; i++) {
+            const std::string argument = argv[i];
+            const size_t separator = argument.find('=');
+            if (argument.rfind("--", 0) != 0 || separator == std::string::npos) {
+                throw std::runtime_error("Expected --name=value, got: " + argument);
+            }
+            const std::string name = argument.substr(2, separator - 2), value = argument.substr(separator + 1);
+            if (name == "kinds") {
+                settings.kinds.clear();
+                for (const std::string &kind: split(value)) {
+                    settings.kinds.push_back(GraphLib::parse_graph_kind(kind));
+                }
+            } else if (name == "variants") {
+                settings.variants = split(value);
+            } else if (name == "min-edges") {
+                settings.min_edges = std::stoull(value);
+            } else if (name == "max-edges") {
+                settings.max_edges = std::stoull(value);
+            } else if (name == "warmup") {
+                settings.warmup = std::stoi(value);
+            } else if (name == "trials") {
+                settings.trials = std::max(1, std::stoi(value));
+            } else if (name == "seed") {
+                settings.seed = std::stoull(value);
+            } else if (name == "threads") {
+                settings.threads = std::stoul(value);
+            } else if (name == "format") {
+                if (value != "text" && value != "csv" && value != "json") {
+                    throw std::runtime_error("Unknown format: " + value);
+                }
+                settings.format = value;
+            } else if (name == "output") {
+                settings.output = value;
+            } else {
+                throw std::runtime_error("Unknown option: --" + name);
+            }
+        }
+        return settings;
+    }
+
+    std::vector<Variant> make_variants(const Settings &settings) {
+        using GraphLib::MSTEngine, GraphLib::FindPolicy, GraphLib::UnionPolicy, GraphLib::SortMode;
+
+        const auto variant = [&settings](const std::string &name, const MSTEngine engine, const SortMode sort_mode,
+                                         const FindPolicy find_policy, const UnionPolicy union_policy) {
+            Variant result{name, {}};
+            result.options.engine = engine;
+            result.options.sort_mode = sort_mode;
+            result.options.find_policy = find_policy;
+            result.options.union_policy = union_policy;
+            result.options.threads = settings.threads;
+            result.options.use_cache = false;
+            return result;
+        };
+
+        std::vector<Variant> variants = {
+            variant("kruskal", MSTEngine::Kruskal, SortMode::Radix, FindPolicy::Compression, UnionPolicy::Rank),
+            variant("kruskal-parallel-sort", MSTEngine::Kruskal, SortMode::ParallelRadix, FindPolicy::Compression,
+                    UnionPolicy::Rank),
+            variant("kruskal-halving", MSTEngine::Kruskal, SortMode::Radix, FindPolicy::Halving, UnionPolicy::Rank),
+            variant("kruskal-splitting", MSTEngine::Kruskal, SortMode::Radix, FindPolicy::Splitting,
+                    UnionPolicy::Rank),
+            variant("kruskal-size", MSTEngine::Kruskal, SortMode::Radix, FindPolicy::Compression, UnionPolicy::Size),
+            variant("kruskal-naive-union", MSTEngine::Kruskal, SortMode::Radix, FindPolicy::Compression,
+                    UnionPolicy::Naive),
+            variant("kruskal-no-compression", MSTEngine::Kruskal, SortMode::Radix, FindPolicy::None,
+                    UnionPolicy::Rank),
+            variant("filter-kruskal", MSTEngine::FilterKruskal, SortMode::Radix, FindPolicy::Compression,
+                    UnionPolicy::Rank),
+            variant("lazy-kruskal", MSTEngine::LazyKruskal, SortMode::Radix, FindPolicy::Compression,
+                    UnionPolicy::Rank),
+            variant("boruvka", MSTEngine::Boruvka, SortMode::Radix, FindPolicy::Compression, UnionPolicy::Rank),
+            variant("prim", MSTEngine::Prim, SortMode::Radix, FindPolicy::Compression, UnionPolicy::Rank),
+            variant("dense-prim", MSTEngine::DensePrim, SortMode::Radix, FindPolicy::Compression, UnionPolicy::Rank),
+            variant("auto", MSTEngine::Auto, SortMode::Radix, FindPolicy::Compression, UnionPolicy::Rank)
+        };
+        if (settings.variants.empty()) {
+            return variants;
+        }
+
+        std::vector<Variant> selected;
+        for (const std::string &name: settings.variants) {
+            const auto found = std::find_if(variants.begin(), variants.end(), [&name](const Variant &item) {
+                return item.name == name;
+            });
+            if (found == variants.end()) {
+                throw std::runtime_error("Unknown variant: " + name);
+            }
+            selected.push_back(*found);
+        }
+        return selected;
+    }
+
+    Stats make_stats(std::vector<double> samples) {
+        std::sort(samples.begin(), samples.end());
+        const size_t middle = samples.size() / 2;
+        const double median = samples.size() % 2 == 1
+                                  ? samples[middle]
+                                  : (samples[middle - 1] + samples[middle]) / 2.0;
+        const auto rank = static_cast<size_t>(std::ceil(0.95 * static_cast<double>(samples.size())));
+        return {median, samples[std::max<size_t>(rank, 1) - 1]};
+    }
+
+    Result run_variant(const GraphLib::Graph &graph, const std::string &kind, const Variant &variant,
+                       const Settings &settings, std::vector<size_t> &reference, const bool is_reference) {
+        GraphLib::MSTMetrics metrics;
+        GraphLib::MSTScratch scratch;
+        std::vector<size_t> mst;
+        for (int i = 0; i < settings.warmup; i++) {
+            mst = graph.get_MST(variant.options, metrics, scratch);
+        }
+
+        std::vector<double> sort_samples, loop_samples, total_samples;
+        for (int i = 0; i < settings.trials; i++) {
+            mst = graph.get_MST(variant.options, metrics, scratch);
+            sort_samples.push_back(metrics.sort.time);
+            loop_samples.push_back(metrics.loop.time);
+            total_samples.push_back(metrics.sort.time + metrics.loop.time + metrics.output.time);
+        }
+
+        GraphLib::MSTOptions counted_options = variant.options;
+        counted_options.count_operations = true;
+        GraphLib::MSTMetrics counted;
+        graph.get_MST(counted_options, counted, scratch);
+
+        double mst_weight = 0.0;
+        for (const size_t edge: mst) {
+            mst_weight += graph.get_edge(edge).weight;
+        }
+
+        Result result{
+            kind, variant.name, GraphLib::engine_name(counted.engine), graph.points_size(), graph.edges_size(),
+            mst.size(), mst_weight,
+            is_reference || reference == mst,
+            make_stats(sort_samples), make_stats(loop_samples), make_stats(total_samples), 0.0,
+            counted.finds, counted.unions, counted.edges_scanned, counted.peak_memory,
+            counted.scratch_memory
+        };
+        result.edges_per_second = result.total.median > 0.0
+                                      ? static_cast<double>(result.edges_size) / result.total.median
+                                      : 0.0;
+        if (is_reference) {
+            reference = std::move(mst);
+        }
+        return result;
+    }
+
+    void write_text(std::ostream &out, const std::vector<Result> &results) {
+        std::string kind;
+        size_t edges_size = 0;
+        for (const Result &result: results) {
+            if (result.kind != kind || result.edges_size != edges_size) {
+                kind = result.kind;
+                edges_size = result.edges_size;
+                out << kind << ": " << result.points_size << " points, " << edges_size << " edges, MST "
+                        << result.mst_size << " edges, weight " << result.mst_weight << "\n";
+            }
+            out << "  " << result.variant;
+            if (result.engine != result.variant) {
+                out << " (" << result.engine << ")";
+            }
+            out << ": sort " << result.sort.median << "s (p95 " << result.sort.p95
+                    << "s), loop " << result.loop.median << "s (p95 " << result.loop.p95 << "s), "
+                    << result.edges_per_second << " edges/s, " << result.edges_scanned << " scanned"
+                    << (result.matches ? "" : "  (MST differs)") << "\n";
+        }
+    }
+
+    void write_csv(std::ostream &out, const std::vector<Result> &results) {
+        out << "kind,variant,engine,points,edges,mst_edges,mst_weight,matches,sort_median,sort_p95,loop_median,"
+                "loop_p95,total_median,total_p95,edges_per_second,finds,unions,edges_scanned,peak_memory,"
+                "scratch_memory\n";
+        for (const Result &result: results) {
+            out << result.kind << "," << result.variant << "," << result.engine << "," << result.points_size << ","
+                    << result.edges_size << "," << result.mst_size << "," << result.mst_weight << ","
+                    << (result.matches ? 1 : 0) << "," << result.sort.median << "," << result.sort.p95 << ","
+                    << result.loop.median << "," << result.loop.p95 << "," << result.total.median << ","
+                    << result.total.p95 << "," << result.edges_per_second << "," << result.finds << ","
+                    << result.unions << "," << result.edges_scanned << "," << result.peak_memory << ","
+                    << result.scratch_memory << "\n";
+        }
+    }
+
+    void write_json(std::ostream &out, const std::vector<Result> &results) {
+        out << "[\n";
+        for (size_t i = 0; i < results.size(); i++) {
+            const Result &result = results[i];
+            out << "  {\"kind\": \"" << result.kind << "\", \"variant\": \"" << result.variant
+                    << "\", \"engine\": \"" << result.engine << "\", \"points\": " << result.points_size
+                    << ", \"edges\": " << result.edges_size << ", \"mst_edges\": " << result.mst_size
+                    << ", \"mst_weight\": " << result.mst_weight
+                    << ", \"matches\": " << (result.matches ? "true" : "false")
+                    << ", \"sort_median\": " << result.sort.median << ", \"sort_p95\": " << result.sort.p95
+                    << ", \"loop_median\": " << result.loop.median << ", \"loop_p95\": " << result.loop.p95
+                    << ", \"total_median\": " << result.total.median << ", \"total_p95\": " << result.total.p95
+                    << ", \"edges_per_second\": " << result.edges_per_second << ", \"finds\": " << result.finds
+                    << ", \"unions\": " << result.unions << ", \"edges_scanned\": " << result.edges_scanned
+                    << ", \"peak_memory\": " << result.peak_memory
+                    << ", \"scratch_memory\": " << result.scratch_memory << "}"
+                    << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        out << "]\n";
+    }
+}
+
+int main(int argc, char *argv[]) {
+    std::vector<Result> results;
+    Settings settings;
+    try {
+        settings = parse_settings(argc, argv);
+        if (settings.min_edges == 0 || settings.min_edges > settings.max_edges) {
+            throw std::runtime_error("Expected 0 < min-edges <= max-edges");
+        }
+        const std::vector<Variant> variants = make_variants(settings);
+
+        std::cerr << "threads: " << GraphLib::resolve_threads(settings.threads) << ", warm-up: " << settings.warmup
+                << ", trials: " << settings.trials << ", seed: " << settings.seed << "\n";
+        for (const GraphLib::GraphKind kind: settings.kinds) {
+            for (size_t edges_size = settings.min_edges; edges_size <= settings.max_edges; edges_size *= 10) {
+                const GraphLib::Graph graph = GraphLib::generate_graph(kind, edges_size, settings.seed);
+                std::cerr << GraphLib::graph_kind_name(kind) << " " << edges_size << "\n";
+
+                std::vector<size_t> reference;
+                bool has_reference = false;
+                for (const Variant &variant: variants) {
+                    // Dense Prim is quadratic in the points, which would dwarf everything else on big sparse graphs.
+                    if (variant.options.engine == GraphLib::MSTEngine::DensePrim &&
+                        graph.points_size() > max_dense_points) {
+                        continue;
+                    }
+                    results.push_back(run_variant(graph, GraphLib::graph_kind_name(kind), variant, settings,
+                                                  reference, !has_reference));
+                    has_reference = true;
+                }
+            }
+        }
+    } catch (const std::exception &e) {
+        std::cout << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::ofstream file;
+    if (!settings.output.empty()) {
+        file.open(settings.output);
+        if (!file) {
+            std::cout << "Cannot open output file: " << settings.output << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    std::ostream &out = settings.output.empty() ? std::cout : file;
+    out.precision(9);
+    if (settings.format == "csv") {
+        write_csv(out, results);
+    } else if (settings.format == "json") {
+        write_json(out, results);
+    } else {
+        write_text(out, results);
+    }
+
+    const bool all_match = std::all_of(results.begin(), results.end(), [](const Result &result) {
+        return result.matches;
+    });
+    return all_match ? EXIT_SUCCESS : EXIT_FAILURE;
+}
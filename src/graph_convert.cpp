@@ -0,0 +1,73 @@
+#include <cstdlib>
+#include <fcntl.h>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+#include "../include/Graph.h"
+#include "../include/GraphWriter.h"
+
+int main(int argc, char *argv[]) {
+    if (argc < 3) {
+        std::cout << "Usage: " << argv[0]
+                << " <input graph> <output.bin|output.csv|output.txt> [--sorted] [--mst] [--dump]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const std::string output = argv[2];
+    bool with_sorted_edges = false, mst_only = false, dump = false;
+    for (int i = 3; i < argc; i++) {
+        const std::string argument = argv[i];
+        if (argument == "--sorted") {
+            with_sorted_edges = true;
+        } else if (argument == "--mst") {
+            mst_only = true;
+        } else if (argument == "--dump") {
+            dump = true;
+        } else {
+            std::cout << "Unknown option: " << argument << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    try {
+        const GraphLib::Graph graph(argv[1]);
+        if (output.ends_with(".bin") && !mst_only && !dump) {
+            graph.save_binary(output, with_sorted_edges);
+        } else {
+            const int fd = ::open(output.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            if (fd < 0) {
+                throw std::runtime_error("Unable to open file from: " + output);
+            }
+            try {
+                GraphLib::GraphWriter writer(fd);
+                if (mst_only) {
+                    const GraphLib::MSTFormat format = output.ends_with(".bin")
+                                                           ? GraphLib::MSTFormat::Binary
+                                                           : output.ends_with(".csv")
+                                                                 ? GraphLib::MSTFormat::CSV
+                                                                 : GraphLib::MSTFormat::Text;
+                    writer.write_MST(graph, graph.get_MST(), format);
+                } else if (dump) {
+                    writer.write_text(graph);
+                } else if (output.ends_with(".csv")) {
+                    writer.write_csv(graph);
+                } else {
+                    writer.write_graph(graph);
+                }
+                writer.flush();
+            } catch (...) {
+                ::close(fd);
+                throw;
+            }
+            ::close(fd);
+        }
+        std::cout << argv[1] << " -> " << output << ": " << graph.points_size() << " points, "
+                << graph.edges_size() << " edges" << (with_sorted_edges ? ", sorted edges" : "")
+                << (mst_only ? ", MST only" : "") << (dump ? ", dump" : "") << std::endl;
+    } catch (const std::exception &e) {
+        std::cout << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,49 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include "../include/Graph.h"
+#include "../include/Renderer.h"
+
+int main(int argc, char *argv[]) {
+    if (argc < 3) {
+        std::cout << "Usage: " << argv[0] << " <input graph> <output.svg|output.png> [--size=N] [--no-edges] "
+                << "[--no-mst] [--no-points] [--edges-limit=N]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const std::string output = argv[2];
+    GraphLib::RenderOptions options;
+    for (int i = 3; i < argc; i++) {
+        const std::string argument = argv[i];
+        if (argument.starts_with("--size=")) {
+            options.width = options.height = static_cast<unsigned>(std::stoul(argument.substr(7)));
+        } else if (argument.starts_with("--edges-limit=")) {
+            options.edges_limit = std::stoull(argument.substr(14));
+        } else if (argument == "--no-edges") {
+            options.with_edges = false;
+        } else if (argument == "--no-mst") {
+            options.with_mst = false;
+        } else if (argument == "--no-points") {
+            options.with_points = false;
+        } else {
+            std::cout << "Unknown option: " << argument << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    try {
+        const GraphLib::Graph graph(argv[1]);
+        const auto start = std::chrono::high_resolution_clock::now();
+        const GraphLib::RenderStats stats = output.ends_with(".png")
+                                                ? GraphLib::render_png(graph, output, options)
+                                                : GraphLib::render_svg(graph, output, options);
+        const std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+        std::cout << argv[1] << " -> " << output << ": " << stats.points_drawn << " points, " << stats.edges_drawn
+                << " edges (" << stats.edges_culled << " culled), " << stats.mst_edges_drawn << " MST edges in "
+                << elapsed.count() << "s" << std::endl;
+    } catch (const std::exception &e) {
+        std::cout << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
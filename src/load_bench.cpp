@@ -0,0 +1,88 @@
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <random>
+#include <chrono>
+#include <vector>
+#include <string>
+#include "../include/Graph.h"
+
+namespace {
+    void write_graph(const std::string &file_path, const size_t points_size, const size_t edges_size) {
+        std::mt19937_64 rng(42);
+        std::uniform_real_distribution<double> coordinate(0.0, 1.0);
+        std::uniform_int_distribution<size_t> index(0, points_size - 1);
+
+        std::ofstream file(file_path);
+        file << points_size << "\n";
+        for (size_t i = 0; i < points_size; i++) {
+            file << coordinate(rng) << " " << coordinate(rng) << "\n";
+        }
+        file << edges_size << "\n";
+        for (size_t i = 0; i < edges_size; i++) {
+            file << index(rng) << " " << index(rng) << " " << coordinate(rng) << "\n";
+        }
+    }
+
+    size_t legacy_load(const std::string &file_path) {
+        std::ifstream file(file_path);
+        std::vector<double> x, y, w;
+        std::vector<size_t> u, v;
+
+        size_t points_size{}, edges_size{};
+        file >> points_size;
+        for (size_t i = 0; i < points_size; i++) {
+            double px, py;
+            file >> px >> py;
+            x.push_back(px);
+            y.push_back(py);
+        }
+
+        file >> edges_size;
+        for (size_t i = 0; i < edges_size; i++) {
+            int index1, index2;
+            double weight;
+            file >> index1 >> index2 >> weight;
+            u.push_back(index1);
+            v.push_back(index2);
+            w.push_back(weight);
+        }
+        return w.size();
+    }
+
+    template<typename F>
+    double best_time(const int repeats, F &&load) {
+        double best = 0.0;
+        for (int i = 0; i < repeats; i++) {
+            const auto start = std::chrono::high_resolution_clock::now();
+            load();
+            const std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+            if (i == 0 || elapsed.count() < best) {
+                best = elapsed.count();
+            }
+        }
+        return best;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    const size_t points_size = argc > 1 ? std::stoull(argv[1]) : 100000;
+    const size_t edges_size = argc > 2 ? std::stoull(argv[2]) : 10000000;
+    const int repeats = argc > 3 ? std::stoi(argv[3]) : 3;
+    const std::string file_path = (std::filesystem::temp_directory_path() / "kruskal_load_bench.txt").string();
+
+    write_graph(file_path, points_size, edges_size);
+    const double file_mb = static_cast<double>(std::filesystem::file_size(file_path)) / (1 << 20);
+
+    const double stream_time = best_time(repeats, [&] { legacy_load(file_path); });
+    const double mapped_time = best_time(repeats, [&] { GraphLib::Graph graph(file_path, 1); });
+    const double parallel_time = best_time(repeats, [&] { GraphLib::Graph graph(file_path); });
+
+    std::cout << "points: " << points_size << ", edges: " << edges_size << ", file: " << file_mb << " MB\n";
+    std::cout << "  ifstream >>           : " << stream_time << "s (" << file_mb / stream_time << " MB/s)\n";
+    std::cout << "  mmap + from_chars (1) : " << mapped_time << "s (" << file_mb / mapped_time << " MB/s)\n";
+    std::cout << "  mmap + from_chars (N) : " << parallel_time << "s (" << file_mb / parallel_time << " MB/s)\n";
+
+    std::filesystem::remove(file_path);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,121 @@
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include "../include/Parallel.h"
+#include "../include/RadixSort.h"
+
+namespace {
+    std::vector<size_t> legacy_bucket_sort(const std::vector<double> &weights) {
+        const size_t n = weights.size();
+        std::vector<size_t> sorted_edges;
+        auto *buckets = new std::vector<size_t>[n];
+
+        for (size_t i = 0; i < n; i++) {
+            auto bucket_index = static_cast<size_t>(weights[i] * static_cast<double>(n) / 1);
+            buckets[bucket_index].push_back(i);
+        }
+
+        for (size_t i = 0; i < n; i++) {
+            for (size_t j = 1; j < buckets[i].size(); j++) {
+                size_t key = buckets[i][j];
+                size_t k = j - 1;
+
+                while (k < buckets[i].size() && weights[buckets[i][k]] > weights[key]) {
+                    buckets[i][k + 1] = buckets[i][k];
+                    k--;
+                }
+
+                buckets[i][k + 1] = key;
+            }
+
+            for (size_t j = 0; j < buckets[i].size(); j++) {
+                sorted_edges.push_back(buckets[i][j]);
+            }
+        }
+
+        delete[] buckets;
+        return sorted_edges;
+    }
+
+    std::vector<size_t> std_sort(const std::vector<double> &weights) {
+        std::vector<size_t> sorted_edges(weights.size());
+        for (size_t i = 0; i < weights.size(); i++) {
+            sorted_edges[i] = i;
+        }
+        std::sort(sorted_edges.begin(), sorted_edges.end(), [&weights](const size_t a, const size_t b) {
+            return weights[a] < weights[b] || (weights[a] == weights[b] && a < b);
+        });
+        return sorted_edges;
+    }
+
+    std::vector<double> make_weights(const std::string &distribution, const size_t n) {
+        std::mt19937_64 rng(42);
+        std::vector<double> weights(n);
+        if (distribution == "uniform") {
+            std::uniform_real_distribution<double> weight(0.0, 1.0);
+            for (double &value: weights) {
+                value = weight(rng);
+            }
+        } else if (distribution == "clustered") {
+            std::normal_distribution<double> weight(0.5, 1e-4);
+            for (double &value: weights) {
+                value = std::clamp(weight(rng), 0.0, std::nextafter(1.0, 0.0));
+            }
+        } else {
+            std::uniform_int_distribution<int> weight(0, 1000);
+            for (double &value: weights) {
+                value = weight(rng);
+            }
+        }
+        return weights;
+    }
+
+    template<typename F>
+    double time_sort(const std::vector<double> &weights, F &&sort) {
+        const auto start = std::chrono::high_resolution_clock::now();
+        const std::vector<size_t> sorted_edges = sort(weights);
+        const std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+
+        for (size_t i = 1; i < sorted_edges.size(); i++) {
+            if (weights[sorted_edges[i - 1]] > weights[sorted_edges[i]]) {
+                std::cout << "  (unsorted output)";
+                break;
+            }
+        }
+        return elapsed.count();
+    }
+}
+
+int main(int argc, char *argv[]) {
+    const size_t n = argc > 1 ? std::stoull(argv[1]) : 1000000;
+    const size_t legacy_limit = argc > 2 ? std::stoull(argv[2]) : 200000;
+    const unsigned threads = argc > 3 ? std::stoul(argv[3]) : 0;
+
+    std::vector<GraphLib::SortItem> buffer;
+    std::cout << "edges: " << n << ", threads: " << GraphLib::resolve_threads(threads) << "\n";
+    for (const std::string distribution: {"uniform", "clustered", "integer"}) {
+        const std::vector<double> weights = make_weights(distribution, n);
+
+        std::cout << distribution << ":\n";
+        if (distribution != "integer" && n <= legacy_limit) {
+            std::cout << "  bucket + insertion: " << time_sort(weights, legacy_bucket_sort) << "s\n";
+        } else {
+            std::cout << "  bucket + insertion: skipped\n";
+        }
+        std::cout << "  std::sort         : " << time_sort(weights, std_sort) << "s\n";
+        std::cout << "  LSD radix         : " << time_sort(weights, [&buffer](const std::vector<double> &w) {
+            std::vector<size_t> sorted_edges;
+            GraphLib::radix_sort_edges(w, buffer, sorted_edges);
+            return sorted_edges;
+        }) << "s\n";
+        std::cout << "  parallel LSD radix: " << time_sort(weights, [&buffer, threads](const std::vector<double> &w) {
+            std::vector<size_t> sorted_edges;
+            GraphLib::radix_sort_edges(w, buffer, sorted_edges, threads);
+            return sorted_edges;
+        }) << "s\n";
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,224 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../include/ExternalKruskal.h"
+#include "../include/Graph.h"
+
+namespace {
+    std::string temp_path(const std::string &name) {
+        return (std::filesystem::temp_directory_path() / ("kruskal_test_" + name)).string();
+    }
+
+    void write_graph(const std::string &file_path, const size_t points_size, const size_t edges_size) {
+        std::mt19937_64 rng(42);
+        std::uniform_real_distribution<double> coordinate(0.0, 1.0);
+        std::uniform_int_distribution<size_t> index(0, points_size - 1);
+
+        std::ofstream file(file_path);
+        file << points_size << "\n";
+        for (size_t i = 0; i < points_size; i++) {
+            file << coordinate(rng) << " " << coordinate(rng) << "\n";
+        }
+        file << edges_size << "\n";
+        for (size_t i = 0; i < edges_size; i++) {
+            file << index(rng) << " " << index(rng) << " " << coordinate(rng) << "\n";
+        }
+    }
+
+    bool loads(const std::string &file_path) {
+        try {
+            GraphLib::Graph graph(file_path);
+            return true;
+        } catch (const std::runtime_error &) {
+            return false;
+        }
+    }
+
+    // Writes value over the uint64 at offset in a copy of the binary graph and reports whether the copy still loads.
+    bool loads_patched(const std::string &source, const std::string &file_path, const uint64_t offset,
+                       const uint64_t value) {
+        std::filesystem::copy_file(source, file_path, std::filesystem::copy_options::overwrite_existing);
+        {
+            std::fstream file(file_path, std::ios::in | std::ios::out | std::ios::binary);
+            file.seekp(static_cast<std::streamoff>(offset));
+            file.write(reinterpret_cast<const char *>(&value), sizeof(value));
+        }
+        const bool result = loads(file_path);
+        std::filesystem::remove(file_path);
+        return result;
+    }
+
+    // Binary graphs are mapped as they are, so out-of-range edge and sorted indices must be rejected on load.
+    bool check_corrupt_binary() {
+        const std::string text_path = temp_path("corrupt_binary.txt"), binary_path = temp_path("corrupt_binary.bin");
+        write_graph(text_path, 100, 1000);
+        GraphLib::Graph(text_path).save_binary(binary_path, true);
+        std::filesystem::remove(text_path);
+
+        GraphLib::BinaryHeader header{};
+        {
+            std::ifstream file(binary_path, std::ios::binary);
+            file.read(reinterpret_cast<char *>(&header), sizeof(header));
+        }
+        const std::string patched_path = binary_path + ".corrupt";
+        const bool intact = loads(binary_path);
+        const bool bad_u = !loads_patched(binary_path, patched_path, header.u_offset + 8 * 7, header.points_size);
+        const bool bad_v = !loads_patched(binary_path, patched_path, header.v_offset + 8 * (header.edges_size - 1),
+                                          static_cast<uint64_t>(-1));
+        const bool bad_sorted = !loads_patched(binary_path, patched_path, header.sorted_offset + 8 * 3,
+                                               header.edges_size);
+        std::filesystem::remove(binary_path);
+
+        std::cout << "  intact " << (intact ? "loads" : "FAILS") << ", bad u " << (bad_u ? "rejected" : "ACCEPTED")
+                << ", bad v " << (bad_v ? "rejected" : "ACCEPTED") << ", bad sorted "
+                << (bad_sorted ? "rejected" : "ACCEPTED") << "\n";
+        return intact && bad_u && bad_v && bad_sorted;
+    }
+
+    // The out-of-core MST must match the in-memory one while its runs stay within the memory budget.
+    bool check_external_budget() {
+        const std::string text_path = temp_path("external_budget.txt");
+        write_graph(text_path, 10000, 200000);
+        const GraphLib::Graph graph(text_path);
+        const std::vector<size_t> expected = graph.get_MST();
+
+        bool passed = true;
+        for (const size_t budget: {size_t(1) << 16, size_t(1) << 20, size_t(1) << 24}) {
+            GraphLib::ExternalKruskal external(text_path, budget);
+            GraphLib::MSTMetrics metrics;
+            const std::vector<GraphLib::Edge> mst = external.get_MST(metrics);
+            bool matches = mst.size() == expected.size();
+            for (size_t i = 0; matches && i < mst.size(); i++) {
+                const GraphLib::Pair pair = graph.get_edge(expected[i]);
+                matches = mst[i].first == pair.first.index && mst[i].second == pair.second.index &&
+                          mst[i].weight == pair.weight;
+            }
+            const bool within_budget = external.get_peak_run_memory() <= budget;
+            std::cout << "  budget " << budget << ": " << external.get_peak_run_memory() << " run bytes, MST "
+                    << (matches ? "matches" : "DIFFERS")
+                    << (within_budget ? "" : ", OVER BUDGET") << "\n";
+            passed = passed && matches && within_budget;
+        }
+        std::filesystem::remove(text_path);
+        return passed;
+    }
+
+    // A text file may end after its points; Graph loads it without edges, so the out-of-core MST is empty.
+    bool check_external_points_only() {
+        const std::string text_path = temp_path("external_points_only.txt");
+        {
+            std::ofstream file(text_path);
+            file << "3\n0 0\n1 1\n2 2\n";
+        }
+        GraphLib::MSTMetrics metrics;
+        const bool empty = GraphLib::Graph(text_path).get_MST().empty() &&
+                           GraphLib::ExternalKruskal(text_path).get_MST(metrics).empty();
+        std::filesystem::remove(text_path);
+        return empty;
+    }
+
+    bool check_external_byte_order() {
+        const std::string text_path = temp_path("external_byte_order.txt");
+        const std::string binary_path = temp_path("external_byte_order.bin");
+        write_graph(text_path, 100, 1000);
+        GraphLib::Graph(text_path).save_binary(binary_path);
+        std::filesystem::remove(text_path);
+        {
+            std::fstream file(binary_path, std::ios::in | std::ios::out | std::ios::binary);
+            const uint32_t swapped = 0x04030201;
+            file.seekp(offsetof(GraphLib::BinaryHeader, byte_order));
+            file.write(reinterpret_cast<const char *>(&swapped), sizeof(swapped));
+        }
+        bool rejected = false;
+        try {
+            GraphLib::MSTMetrics metrics;
+            GraphLib::ExternalKruskal(binary_path).get_MST(metrics);
+        } catch (const std::runtime_error &e) {
+            std::cout << "  " << e.what() << "\n";
+            rejected = true;
+        }
+        std::filesystem::remove(binary_path);
+        return rejected;
+    }
+
+    // add_point is protected; a graph that grows point by point, as subclasses do, reaches it through this one.
+    struct GrowingGraph : GraphLib::Graph {
+        using Graph::Graph;
+        using Graph::add_point;
+    };
+
+    // The cached adjacency index has a row per point, so it must be rebuilt after add_point as well as add_edge.
+    bool check_prim_after_add_point() {
+        const std::string text_path = temp_path("prim_after_add_point.txt");
+        write_graph(text_path, 500, 2000);
+        bool passed = true;
+        for (const GraphLib::MSTEngine engine: {GraphLib::MSTEngine::Prim, GraphLib::MSTEngine::DensePrim}) {
+            GrowingGraph graph(text_path);
+            GraphLib::MSTOptions options;
+            options.engine = engine;
+            options.use_cache = true;
+            graph.get_MST(options);
+
+            graph.add_point(0.5, 0.5);
+            const bool after_point = graph.get_MST(options) == graph.get_MST();
+            graph.add_edge(graph.points_size() - 1, 0, 0.0);
+            const bool after_edge = graph.get_MST(options) == graph.get_MST();
+            const bool rebuilt = graph.get_cache_stats().adjacency_misses == 3;
+
+            std::cout << "  " << GraphLib::engine_name(engine) << ": after add_point "
+                    << (after_point ? "matches" : "DIFFERS") << ", after add_edge "
+                    << (after_edge ? "matches" : "DIFFERS") << (rebuilt ? "" : ", adjacency NOT REBUILT") << "\n";
+            passed = passed && after_point && after_edge && rebuilt;
+        }
+        std::filesystem::remove(text_path);
+        return passed;
+    }
+
+    struct Check {
+        const char *name;
+        bool (*run)();
+    };
+
+    const std::vector<Check> checks = {
+        {"corrupt_binary", check_corrupt_binary},
+        {"external_budget", check_external_budget},
+        {"external_points_only", check_external_points_only},
+        {"external_byte_order", check_external_byte_order},
+        {"prim_after_add_point", check_prim_after_add_point},
+    };
+}
+
+// Runs the checks named on the command line, or all of them, and fails if any of them does.
+int main(int argc, char *argv[]) {
+    std::vector<std::string> names(argv + 1, argv + argc);
+    for (const std::string &name: names) {
+        if (std::ranges::none_of(checks, [&name](const Check &check) { return check.name == name; })) {
+            std::cout << "Unknown check: " << name << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    int failures = 0;
+    for (const Check &check: checks) {
+        if (!names.empty() && std::ranges::find(names, check.name) == names.end()) {
+            continue;
+        }
+        std::cout << check.name << "\n";
+        bool passed = false;
+        try {
+            passed = check.run();
+        } catch (const std::exception &e) {
+            std::cout << "  " << e.what() << "\n";
+        }
+        std::cout << (passed ? "  passed" : "  FAILED") << std::endl;
+        failures += passed ? 0 : 1;
+    }
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}